@@ -448,6 +448,23 @@ poll(&pfd, 1, 0);
 }
 ")
 
+# copy_file_range
+qt_config_compile_test(copy_file_range
+    LABEL "copy_file_range()"
+    CODE
+"#define _GNU_SOURCE 1
+#include <unistd.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+ssize_t n = copy_file_range(0, nullptr, 1, nullptr, 1, 0);
+(void) n;
+    /* END TEST: */
+    return 0;
+}
+")
+
 # renameat2
 qt_config_compile_test(renameat2
     LABEL "renameat2()"
@@ -714,6 +731,10 @@ qt_feature("qqnx_pps" PRIVATE
     CONDITION PPS_FOUND
     EMIT_IF QNX
 )
+qt_feature("copy_file_range" PRIVATE
+    LABEL "copy_file_range()"
+    CONDITION LINUX AND TEST_copy_file_range
+)
 qt_feature("renameat2" PRIVATE
     LABEL "renameat2()"
     CONDITION ( LINUX OR HURD ) AND TEST_renameat2
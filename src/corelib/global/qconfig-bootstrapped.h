@@ -42,6 +42,7 @@
 #endif
 #define QT_FEATURE_cborstreamreader -1
 #define QT_FEATURE_cborstreamwriter 1
+#define QT_FEATURE_copy_file_range -1
 #define QT_CRYPTOGRAPHICHASH_ONLY_SHA1
 #define QT_FEATURE_cxx11_random (__has_include(<random>) ? 1 : -1)
 #define QT_FEATURE_cxx17_filesystem -1
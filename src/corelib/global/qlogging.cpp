@@ -20,8 +20,13 @@
 #include "qelapsedtimer.h"
 #include "qdeadlinetimer.h"
 #include "qdatetime.h"
+#include "qendian.h"
+#include "qhash.h"
 #include "qcoreapplication.h"
 #include "qthread.h"
+#if QT_CONFIG(thread)
+#include "qwaitcondition.h"
+#endif
 #include "private/qloggingregistry_p.h"
 #include "private/qcoreapplication_p.h"
 #include <qtcore_tracepoints_p.h>
@@ -120,6 +125,7 @@ static QT_PREPEND_NAMESPACE(qint64) qt_gettid()
 
 #include <cstdlib>
 #include <algorithm>
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -1890,6 +1896,208 @@ static bool wasm_default_message_handler(QtMsgType type,
 
 // --------------------------------------------------------------------------
 
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+namespace {
+// Writes the stderr output of the default message handler on a background
+// thread, so that threads that log do not block on a slow stderr. Enabled
+// by setting QT_LOGGING_ASYNC to 1. Messages are formatted on the logging
+// thread and written in the order in which they were logged; if the writer
+// falls too far behind, new messages are dropped and the number of dropped
+// messages is reported instead.
+class AsyncStderrWriter : public QThread
+{
+public:
+    AsyncStderrWriter()
+    {
+        setObjectName(QStringLiteral("Qt logging"));
+        start();
+    }
+
+    ~AsyncStderrWriter() override
+    {
+        {
+            QMutexLocker locker(&mutex);
+            stopping = true;
+            messagesQueued.wakeOne();
+        }
+        wait();
+    }
+
+    void post(QByteArray &&line)
+    {
+        QMutexLocker locker(&mutex);
+        if (queue.size() >= MaxQueuedMessages) {
+            ++droppedCount;
+            return;
+        }
+        queue.push_back(std::move(line));
+        messagesQueued.wakeOne();
+    }
+
+    void flush()
+    {
+        QMutexLocker locker(&mutex);
+        while (!queue.empty() || writing)
+            queueDrained.wait(&mutex);
+    }
+
+private:
+    static constexpr qsizetype MaxQueuedMessages = 8192;
+
+    void run() override
+    {
+        QMutexLocker locker(&mutex);
+        for (;;) {
+            while (queue.empty() && !stopping)
+                messagesQueued.wait(&mutex);
+            if (queue.empty())
+                break;
+
+            std::deque<QByteArray> batch;
+            batch.swap(queue);
+            const qsizetype dropped = std::exchange(droppedCount, 0);
+            writing = true;
+            locker.unlock();
+
+            for (const QByteArray &line : batch)
+                fwrite(line.constData(), 1, line.size(), stderr);
+            if (dropped)
+                fprintf(stderr, "QT_LOGGING_ASYNC: %lld messages were dropped\n",
+                        static_cast<long long>(dropped));
+            fflush(stderr);
+
+            locker.relock();
+            writing = false;
+            if (queue.empty())
+                queueDrained.wakeAll();
+        }
+    }
+
+    QMutex mutex;
+    QWaitCondition messagesQueued;
+    QWaitCondition queueDrained;
+    std::deque<QByteArray> queue;
+    qsizetype droppedCount = 0;
+    bool writing = false;
+    bool stopping = false;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(AsyncStderrWriter, asyncStderrWriter)
+
+static AsyncStderrWriter *asyncStderrWriterIfEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QT_LOGGING_ASYNC");
+    // Messages logged during and after exit() are written synchronously.
+    if (!enabled || asyncStderrWriter.isDestroyed())
+        return nullptr;
+    return asyncStderrWriter();
+}
+#endif // QT_CONFIG(thread) && !QT_BOOTSTRAPPED
+
+#if !defined(QT_BOOTSTRAPPED)
+namespace {
+// Writes messages in the binary format described in qlogging_p.h to the
+// file named by QT_LOGGING_BINARY, instead of formatting them as text.
+// Strings that repeat, like category names and source locations, are
+// written once and referred to by number afterwards.
+class BinaryLogWriter
+{
+public:
+    BinaryLogWriter()
+    {
+        const QByteArray fileName = qgetenv("QT_LOGGING_BINARY");
+        file = fopen(fileName.constData(), "wb");
+        if (!file) {
+            fprintf(stderr, "QT_LOGGING_BINARY: cannot open %s, logging as text\n",
+                    fileName.constData());
+            return;
+        }
+        timer.start();
+        QByteArray header(QBinaryLogFormat::Magic, sizeof(QBinaryLogFormat::Magic));
+        appendInteger(header, QBinaryLogFormat::Version);
+        appendInteger(header, QDateTime::currentMSecsSinceEpoch());
+        fwrite(header.constData(), 1, header.size(), file);
+    }
+
+    ~BinaryLogWriter()
+    {
+        if (file)
+            fclose(file);
+    }
+
+    bool isOpen() const { return file != nullptr; }
+
+    void write(QtMsgType type, const QMessageLogContext &context, const QString &message)
+    {
+        const qint64 elapsed = timer.nsecsElapsed();
+        const QByteArray text = message.toUtf8();
+
+        QMutexLocker locker(&mutex);
+        record.clear();
+        const quint32 category = stringId(context.category);
+        const quint32 fileName = stringId(context.file);
+        const quint32 function = stringId(context.function);
+        record.append(char(QBinaryLogFormat::MessageRecord));
+        record.append(char(type));
+        appendInteger(record, elapsed);
+        appendInteger(record, quint64(qt_gettid()));
+        appendInteger(record, category);
+        appendInteger(record, fileName);
+        appendInteger(record, function);
+        appendInteger(record, qint32(context.line));
+        appendInteger(record, quint32(text.size()));
+        record.append(text);
+        fwrite(record.constData(), 1, record.size(), file);
+        if (type == QtFatalMsg)
+            fflush(file);
+    }
+
+private:
+    template <typename T>
+    static void appendInteger(QByteArray &out, T value)
+    {
+        const T le = qToLittleEndian(value);
+        out.append(reinterpret_cast<const char *>(&le), sizeof(le));
+    }
+
+    // Defines the string in the current record if it wasn't seen before.
+    quint32 stringId(const char *string)
+    {
+        if (!string)
+            return 0;
+        const QByteArray key = QByteArray::fromRawData(string, qstrlen(string));
+        if (const auto it = strings.constFind(key); it != strings.cend())
+            return *it;
+
+        const quint32 id = quint32(strings.size()) + 1;
+        strings.insert(QByteArray(key.constData(), key.size()), id);
+        record.append(char(QBinaryLogFormat::StringRecord));
+        appendInteger(record, id);
+        appendInteger(record, quint32(key.size()));
+        record.append(key);
+        return id;
+    }
+
+    QMutex mutex;
+    FILE *file = nullptr;
+    QElapsedTimer timer;
+    QHash<QByteArray, quint32> strings;
+    QByteArray record;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(BinaryLogWriter, binaryLogWriter)
+
+static BinaryLogWriter *binaryLogWriterIfEnabled()
+{
+    static const bool enabled = !qEnvironmentVariableIsEmpty("QT_LOGGING_BINARY");
+    if (!enabled || binaryLogWriter.isDestroyed() || !binaryLogWriter->isOpen())
+        return nullptr;
+    return binaryLogWriter();
+}
+#endif // !QT_BOOTSTRAPPED
+
 static void stderr_message_handler(QtMsgType type, const QMessageLogContext &context, const QString &message)
 {
     QString formattedMessage = qFormatLogMessage(type, context, message);
@@ -1899,6 +2107,18 @@ static void stderr_message_handler(QtMsgType type, const QMessageLogContext &con
     if (formattedMessage.isNull())
         return;
 
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+    if (AsyncStderrWriter *writer = asyncStderrWriterIfEnabled()) {
+        if (type != QtFatalMsg) {
+            writer->post(std::move(formattedMessage).toLocal8Bit() + '\n');
+            return;
+        }
+        // The application is about to abort; make sure everything before
+        // this message is written first.
+        writer->flush();
+    }
+#endif
+
     fprintf(stderr, "%s\n", formattedMessage.toLocal8Bit().constData());
     fflush(stderr);
 }
@@ -1911,6 +2131,13 @@ static void qDefaultMessageHandler(QtMsgType type, const QMessageLogContext &con
 {
     bool handledStderr = false;
 
+#if !defined(QT_BOOTSTRAPPED)
+    if (BinaryLogWriter *writer = binaryLogWriterIfEnabled()) {
+        writer->write(type, context, message);
+        return;
+    }
+#endif
+
     // A message sink logs the message to a structured or unstructured destination,
     // optionally formatting the message if the latter, and returns true if the sink
     // handled stderr output as well, which will shortcut our default stderr output.
@@ -2116,6 +2343,20 @@ void qErrnoWarning(int code, const char *msg, ...)
     environment variable. To keep this formatting, a custom message handler
     can use \l qFormatLogMessage().
 
+    When the default message handler writes to \c stderr, it can do so on a
+    background thread instead of the thread that logs. To enable this, set
+    the \c QT_LOGGING_ASYNC environment variable to \c 1. Messages are still
+    written in order, but if \c stderr cannot keep up, messages are dropped
+    and a count of the dropped messages is written in their place. Fatal
+    messages are always written synchronously. Custom message handlers are
+    always called on the thread that logs.
+
+    To keep the cost of logging low, the default message handler can also
+    write messages in a compact binary format instead, by setting the
+    \c QT_LOGGING_BINARY environment variable to the name of a file. The
+    message pattern is not applied then; use the \c qtlogdecode tool to turn
+    the file into text.
+
     Try to keep the code in the message handler itself minimal, as expensive
     operations might block the application. Also, to avoid recursion, any
     logging messages generated in the message handler itself will be ignored.
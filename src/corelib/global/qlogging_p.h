@@ -25,6 +25,30 @@ Q_CORE_EXPORT bool shouldLogToStderr();
 
 }
 
+// The binary log written by the default message handler when
+// QT_LOGGING_BINARY is set, and read by qtlogdecode. All integers are
+// little-endian.
+//
+// The file starts with Magic, the quint32 Version, and the qint64 time at
+// which logging started, in milliseconds since the epoch (UTC). Records
+// follow, each starting with a quint8 RecordType:
+//
+//   StringRecord:  quint32 id (> 0), quint32 size, size bytes of UTF-8.
+//   MessageRecord: quint8 QtMsgType, qint64 nanoseconds since the start,
+//                  quint64 thread id, quint32 category, file and function
+//                  string ids (0 for none), qint32 line, quint32 size,
+//                  size bytes of UTF-8 message.
+//
+// A string is always defined before the first message that refers to it.
+namespace QBinaryLogFormat {
+constexpr char Magic[8] = { 'Q', 'T', 'L', 'O', 'G', 'B', 'I', 'N' };
+constexpr quint32 Version = 1;
+enum RecordType : quint8 {
+    StringRecord = 1,
+    MessageRecord = 2,
+};
+}
+
 QT_END_NAMESPACE
 
 #endif // QLOGGING_P_H
@@ -18,6 +18,12 @@
 #if defined(QT_BUILD_CORE_LIB)
 # include "qcoreapplication.h"
 #endif
+#if QT_CONFIG(future)
+# include "qfuture.h"
+# include "qpromise.h"
+# include "qthreadpool.h"
+# include "private/qbytearray_p.h"
+#endif
 
 #ifdef QT_NO_QOBJECT
 #define tr(X) QString::fromLatin1(X)
@@ -1158,6 +1164,188 @@ qint64 QFile::size() const
     return QFileDevice::size(); // for now
 }
 
+#if QT_CONFIG(future)
+namespace {
+// File I/O blocks, so it should not occupy the threads of
+// QThreadPool::globalInstance(), which is meant for CPU-bound work.
+class QFileIoThreadPool : public QThreadPool
+{
+public:
+    QFileIoThreadPool() { setObjectName(u"QFile I/O"_s); }
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QFileIoThreadPool, fileIoThreadPool)
+
+static constexpr qint64 AsyncChunkSize = 1024 * 1024;
+
+static void adviseReadAhead(const QFile &file, qint64 offset, qint64 length, bool sequential)
+{
+#if defined(Q_OS_UNIX) && defined(POSIX_FADV_SEQUENTIAL)
+    // These are only hints, failing to give them is harmless.
+    const int advice = sequential ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_WILLNEED;
+    ::posix_fadvise(file.handle(), QT_OFF_T(offset), QT_OFF_T(length), advice);
+#else
+    Q_UNUSED(file);
+    Q_UNUSED(offset);
+    Q_UNUSED(length);
+    Q_UNUSED(sequential);
+#endif
+}
+
+static bool readFileAsync(QPromise<QByteArray> &promise, const QString &fileName,
+                          qint64 offset, qint64 maxSize)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+        return false;
+    if (offset && !file.seek(offset))
+        return false;
+
+    qint64 expected = maxSize;
+    if (!file.isSequential()) {
+        const qint64 available = qMax(file.size() - offset, qint64(0));
+        expected = maxSize < 0 ? available : qMin(maxSize, available);
+        if (expected >= MaxByteArraySize)
+            return false;
+        adviseReadAhead(file, offset, expected, true);
+    }
+
+    QByteArray result;
+    if (expected > 0)
+        result.reserve(expected);
+    while (expected < 0 || result.size() < expected) {
+        if (promise.isCanceled())
+            return false;
+
+        const qint64 chunkSize = expected < 0 ? AsyncChunkSize
+                                              : qMin(AsyncChunkSize, expected - result.size());
+        const qsizetype oldSize = result.size();
+        // Let the kernel fetch the next chunk while we copy this one.
+        if (!file.isSequential())
+            adviseReadAhead(file, offset + oldSize + chunkSize, AsyncChunkSize, false);
+
+        result.resize(oldSize + chunkSize);
+        const qint64 readBytes = file.read(result.data() + oldSize, chunkSize);
+        if (readBytes < 0)
+            return false;
+        result.truncate(oldSize + readBytes);
+        if (readBytes < chunkSize)
+            break;
+    }
+
+    promise.addResult(std::move(result));
+    return true;
+}
+
+static bool writeFileAsync(QPromise<qint64> &promise, const QString &fileName,
+                           const QByteArray &data, qint64 offset)
+{
+    // Unlike WriteOnly, ReadWrite does not truncate the file.
+    QFile file(fileName);
+    const QIODevice::OpenMode mode = offset < 0 ? QIODevice::Append : QIODevice::ReadWrite;
+    if (!file.open(mode | QIODevice::Unbuffered))
+        return false;
+    if (offset > 0 && !file.seek(offset))
+        return false;
+
+    qint64 written = 0;
+    while (written < data.size()) {
+        if (promise.isCanceled())
+            return false;
+
+        const qint64 chunkSize = qMin(AsyncChunkSize, data.size() - written);
+        if (file.write(data.constData() + written, chunkSize) != chunkSize)
+            return false;
+        written += chunkSize;
+    }
+
+    promise.addResult(written);
+    return true;
+}
+
+/*!
+    \since 6.7
+
+    Reads up to \a maxSize bytes from the file, starting at \a offset,
+    without blocking the calling thread. If \a maxSize is -1, the file is
+    read up to its end. Returns a QFuture that provides the data once it has
+    been read.
+
+    The file is read on a thread pool reserved for file I/O, through a
+    separate handle opened by name. Therefore, it does not matter whether
+    this QFile is open, and its position and buffers are not affected. Call
+    flush() first if this QFile has written data that the read should see.
+
+    The data is read in chunks, and the operation stops between two chunks
+    if the returned future is canceled. If the file cannot be opened or
+    read, the future is canceled and has no result.
+
+    Where the operating system supports it, the file is announced to be read
+    sequentially, so that the kernel reads ahead of the requests.
+
+    \sa writeAsync(), read()
+*/
+QFuture<QByteArray> QFile::readAsync(qint64 offset, qint64 maxSize) const
+{
+    QPromise<QByteArray> promise;
+    QFuture<QByteArray> future = promise.future();
+    if (offset < 0 || maxSize < -1) {
+        qWarning("QFile::readAsync: Called with offset < 0 or maxSize < -1");
+        return future; // canceled when the promise goes out of scope
+    }
+
+    // Start before queuing, so that waiting on the future blocks until
+    // the worker has run.
+    promise.start();
+    fileIoThreadPool()->start([promise = std::move(promise), fileName = fileName(),
+                               offset, maxSize]() mutable {
+        if (!readFileAsync(promise, fileName, offset, maxSize))
+            promise.future().cancel();
+        promise.finish();
+    });
+    return future;
+}
+
+/*!
+    \since 6.7
+
+    Writes \a data to the file at \a offset without blocking the calling
+    thread, and returns a QFuture that provides the number of bytes written.
+    If \a offset is -1, the data is appended to the end of the file. The
+    file is created if it does not exist, but it is never truncated.
+
+    Like readAsync(), this function works on a separate handle, on a thread
+    pool reserved for file I/O. Data that is still buffered in this QFile is
+    not taken into account.
+
+    The data is written in chunks, and the operation stops between two
+    chunks if the returned future is canceled. If the file cannot be opened
+    or written, the future is canceled and has no result; part of the data
+    may have been written in that case.
+
+    \sa readAsync(), write()
+*/
+QFuture<qint64> QFile::writeAsync(const QByteArray &data, qint64 offset) const
+{
+    QPromise<qint64> promise;
+    QFuture<qint64> future = promise.future();
+    if (offset < -1) {
+        qWarning("QFile::writeAsync: Called with offset < -1");
+        return future; // canceled when the promise goes out of scope
+    }
+
+    promise.start();
+    fileIoThreadPool()->start([promise = std::move(promise), fileName = fileName(),
+                               data, offset]() mutable {
+        if (!writeFileAsync(promise, fileName, data, offset))
+            promise.future().cancel();
+        promise.finish();
+    });
+    return future;
+}
+#endif // QT_CONFIG(future)
+
 /*!
     \fn QFile::QFile(const std::filesystem::path &name)
     \since 6.0
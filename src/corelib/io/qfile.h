@@ -26,6 +26,10 @@ namespace std {
 
 QT_BEGIN_NAMESPACE
 
+#if QT_CONFIG(future)
+template <typename T> class QFuture;
+#endif
+
 #if defined(Q_OS_WIN) || defined(Q_QDOC)
 
 #if QT_DEPRECATED_SINCE(6,6)
@@ -312,6 +316,11 @@ public:
     }
 #endif // QT_CONFIG(cxx17_filesystem)
 
+#if QT_CONFIG(future) || defined(Q_QDOC)
+    QFuture<QByteArray> readAsync(qint64 offset = 0, qint64 maxSize = -1) const;
+    QFuture<qint64> writeAsync(const QByteArray &data, qint64 offset = -1) const;
+#endif
+
 protected:
 #ifdef QT_NO_QOBJECT
     QFile(QFilePrivate &dd);
@@ -511,6 +511,38 @@ bool QFileDevicePrivate::putCharHelper(char c)
 #endif
 }
 
+/*!
+    \internal
+
+    Only random-access files are read directly: the engine may read through
+    a stdio \c FILE, whose buffer is only in sync with the descriptor after a
+    seek.
+*/
+int QFileDevicePrivate::transferSourceDescriptor()
+{
+    Q_Q(QFileDevice);
+    if (!fileEngine || isSequential() || !q->seek(pos))
+        return -1;
+    return fileEngine->handle();
+}
+
+/*!
+    \internal
+*/
+int QFileDevicePrivate::transferTargetDescriptor()
+{
+    Q_Q(QFileDevice);
+    if (!fileEngine || !q->flush())
+        return -1;
+    if (!isSequential()) {
+        if (!q->seek(pos))
+            return -1;
+        // The data we are about to write directly would make it stale.
+        buffer.clear();
+    }
+    return fileEngine->handle();
+}
+
 /*!
   \reimp
 */
@@ -50,6 +50,8 @@ protected:
     inline bool ensureFlushed() const;
 
     bool putCharHelper(char c) override;
+    int transferSourceDescriptor() override;
+    int transferTargetDescriptor() override;
 
     void setError(QFileDevice::FileError err);
     void setError(QFileDevice::FileError err, const QString &errorString);
@@ -91,6 +91,7 @@ public:
                              QFileSystemMetaData::MetaDataFlags what);
 #if defined(Q_OS_UNIX)
     static bool cloneFile(int srcfd, int dstfd, const QFileSystemMetaData &knownData);
+    static qint64 transferData(int srcfd, int dstfd, qint64 maxSize);
     static bool fillMetaData(int fd, QFileSystemMetaData &data); // what = PosixStatFlags
     static QByteArray id(int fd);
     static bool setFileTime(int fd, const QDateTime &newDate,
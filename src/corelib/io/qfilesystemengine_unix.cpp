@@ -1081,6 +1081,57 @@ bool QFileSystemEngine::cloneFile(int srcfd, int dstfd, const QFileSystemMetaDat
 #endif
 }
 
+// static
+qint64 QFileSystemEngine::transferData(int srcfd, int dstfd, qint64 maxSize)
+{
+#if defined(Q_OS_LINUX)
+    // Both calls advance the offsets of the descriptors, like read(2) and
+    // write(2) would. sendfile(2) is limited in the kernel to 2G - 4k.
+    const qint64 MaxChunkSize = 0x7ffff000;
+#if QT_CONFIG(copy_file_range)
+    bool useCopyFileRange = true;
+#endif
+    qint64 transferred = 0;
+    while (maxSize < 0 || transferred < maxSize) {
+        const size_t chunkSize = size_t(maxSize < 0 ? MaxChunkSize
+                                                    : qMin(maxSize - transferred, MaxChunkSize));
+        ssize_t n;
+#if QT_CONFIG(copy_file_range)
+        if (useCopyFileRange) {
+            // copy_file_range(2) only works between regular files, but lets
+            // the filesystem share the blocks or copy them server-side.
+            n = ::copy_file_range(srcfd, nullptr, dstfd, nullptr, chunkSize, 0);
+            if (n == -1 && (errno == EXDEV || errno == EINVAL || errno == ENOSYS
+                            || errno == EOPNOTSUPP || errno == EBADF)) {
+                useCopyFileRange = false;
+                continue;
+            }
+        } else
+#endif
+        {
+            n = ::sendfile(dstfd, srcfd, nullptr, chunkSize);
+        }
+
+        if (n == 0)
+            break;      // end of file
+        if (n == -1) {
+            if (errno == EINTR)
+                continue;
+            // EAGAIN means a non-blocking target is full. For anything else,
+            // let the caller retry at an upper layer if nothing was sent.
+            return transferred ? transferred : qint64(-1);
+        }
+        transferred += n;
+    }
+    return transferred;
+#else
+    Q_UNUSED(srcfd);
+    Q_UNUSED(dstfd);
+    Q_UNUSED(maxSize);
+    return -1;
+#endif
+}
+
 // Note: if \a shouldMkdirFirst is false, we assume the caller did try to mkdir
 // before calling this function.
 static bool createDirectoryWithParents(const QByteArray &nativeName, mode_t mode,
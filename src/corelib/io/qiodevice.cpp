@@ -11,6 +11,9 @@
 #include "qdir.h"
 #include "private/qbytearray_p.h"
 #include "private/qtools_p.h"
+#if defined(Q_OS_UNIX)
+#include "private/qfilesystemengine_p.h"
+#endif
 
 #include <algorithm>
 
@@ -2047,6 +2050,224 @@ qint64 QIODevice::skipData(qint64 maxSize)
     return d_func()->skipByReading(maxSize);
 }
 
+/*!
+    \since 6.7
+
+    Transfers up to \a maxSize bytes from this device to the \a target
+    device, or all remaining data if \a maxSize is -1. Returns the number of
+    bytes actually transferred, or -1 on error.
+
+    Like read(), this function does not wait: for sequential devices, only
+    the data that is already available for reading is transferred. The
+    transfer also stops if \a target does not accept all of the data
+    written to it. For random-access devices, the data that \a target did
+    not accept remains available for reading.
+
+    If \a target is a sequential device, such as a socket, no more data is
+    queued once its bytesToWrite() reaches an internal limit, and a partial
+    count is returned. Call this function again when \a target emits
+    bytesWritten() to resume the transfer.
+
+    When both devices are backed by a file descriptor, the data is moved by
+    the operating system without being copied through the application (for
+    instance, using \c copy_file_range() or \c sendfile() on Linux). This
+    applies to files as well as to connected QTcpSocket and QLocalSocket
+    targets. Data sent this way is not reported by the target's
+    bytesWritten() signal. Otherwise, the data is copied through a
+    fixed-size buffer.
+
+    \sa read(), write(), skip()
+*/
+qint64 QIODevice::transferTo(QIODevice *target, qint64 maxSize)
+{
+    Q_D(QIODevice);
+    CHECK_READABLE(transferTo, qint64(-1));
+    if (maxSize < -1) {
+        checkWarnMessage(this, "transferTo", "Called with maxSize < -1");
+        return qint64(-1);
+    }
+    if (!target || target == this) {
+        checkWarnMessage(this, "transferTo", "Invalid target device");
+        return qint64(-1);
+    }
+    if (!target->isWritable()) {
+        checkWarnMessage(this, "transferTo", "Target device is not writable");
+        return qint64(-1);
+    }
+
+    qint64 transferred = 0;
+
+#if defined(Q_OS_UNIX)
+    // Text mode translation and transactions need the data to pass through
+    // our buffers.
+    const bool textMode = ((d->openMode | target->openMode()) & QIODevice::Text) != 0;
+    if (!textMode && !d->transactionStarted) {
+        // Any data in our read buffer is ahead of the descriptor's position.
+        if (!d->buffer.isEmpty()) {
+            const qint64 buffered = maxSize < 0 ? d->buffer.size()
+                                                : qMin(d->buffer.size(), maxSize);
+            const qint64 result = d->transferByCopying(target, buffered);
+            if (result != buffered)
+                return result;
+            transferred = result;
+            if (maxSize > 0)
+                maxSize -= result;
+        }
+
+        QIODevicePrivate *targetPrivate = target->d_func();
+        const int srcfd = maxSize ? d->transferSourceDescriptor() : -1;
+        const int dstfd = srcfd != -1 ? targetPrivate->transferTargetDescriptor() : -1;
+        if (dstfd != -1) {
+            const qint64 result = QFileSystemEngine::transferData(srcfd, dstfd, maxSize);
+            if (result > 0) {
+                // The descriptors' offsets have moved, let the devices catch up.
+                if (!d->isSequential())
+                    seek(d->pos + result);
+                if (!targetPrivate->isSequential())
+                    target->seek(targetPrivate->pos + result);
+                transferred += result;
+                if (result == maxSize)
+                    return transferred;
+                if (maxSize > 0)
+                    maxSize -= result;
+            }
+        }
+    }
+#endif
+
+    const qint64 result = d->transferByCopying(target, maxSize);
+    if (transferred == 0)
+        return result;
+    if (result == -1)
+        return transferred;
+    return transferred + result;
+}
+
+/*!
+    \internal
+
+    Copies up to \a maxSize bytes (or all available data, if \a maxSize is
+    -1) to \a target through a stack buffer. Sequential targets usually
+    accept everything into an unbounded write buffer, so stop feeding them
+    once they have enough data queued.
+*/
+qint64 QIODevicePrivate::transferByCopying(QIODevice *target, qint64 maxSize)
+{
+    Q_Q(QIODevice);
+    const qint64 TargetBufferLimit = 4 * QIODEVICE_BUFFERSIZE;
+    const bool targetSequential = get(target)->isSequential();
+    qint64 transferred = 0;
+    char chunk[QIODEVICE_BUFFERSIZE];
+    while (maxSize != 0) {
+        if (targetSequential && target->bytesToWrite() >= TargetBufferLimit)
+            break;
+
+        const qint64 chunkSize = maxSize < 0 ? qint64(sizeof(chunk))
+                                             : qMin<qint64>(maxSize, sizeof(chunk));
+        const qint64 readBytes = read(chunk, chunkSize);
+        if (readBytes <= 0)
+            return transferred ? transferred : readBytes;
+
+        const qint64 written = target->write(chunk, readBytes);
+        if (written != readBytes) {
+            // Give back what the target did not accept, if we can.
+            if (!isSequential())
+                q->seek(pos - (readBytes - qMax<qint64>(written, 0)));
+            if (written > 0)
+                transferred += written;
+            return transferred ? transferred : qint64(-1);
+        }
+
+        transferred += written;
+        if (maxSize > 0)
+            maxSize -= written;
+
+        // Do not try again, if we got less data.
+        if (readBytes < chunkSize)
+            break;
+    }
+    return transferred;
+}
+
+/*!
+    \internal
+
+    Returns a descriptor that QIODevice::transferTo() can read from directly,
+    or -1 if the device has none. The base implementation returns -1.
+*/
+int QIODevicePrivate::transferSourceDescriptor()
+{
+    return -1;
+}
+
+/*!
+    \internal
+
+    Returns a descriptor that QIODevice::transferTo() can write to directly,
+    or -1 if the device has none. The base implementation returns -1.
+*/
+int QIODevicePrivate::transferTargetDescriptor()
+{
+    return -1;
+}
+
+/*!
+    \since 6.7
+
+    Holds back data written to the device until uncork() is called, so that
+    several small writes can be sent together. Calls to cork() nest; the
+    device stays corked until each of them is matched by a call to uncork().
+
+    This is a hint: devices that do not buffer their output, such as QFile
+    opened with QIODevice::Unbuffered, ignore it. QAbstractSocket and
+    QLocalSocket queue all data written while corked and hand it to the
+    operating system in a single call once the device is uncorked. Calling
+    flush() or one of the waitFor functions still writes the queued data.
+
+    \sa uncork(), isCorked(), write()
+*/
+void QIODevice::cork()
+{
+    Q_D(QIODevice);
+    if (d->corkCount++ == 0)
+        d->corkStateChanged();
+}
+
+/*!
+    \since 6.7
+
+    Undoes one call to cork(). When the last one is undone, any data that
+    was held back is sent.
+
+    \sa cork(), isCorked()
+*/
+void QIODevice::uncork()
+{
+    Q_D(QIODevice);
+    if (d->corkCount == 0) {
+        checkWarnMessage(this, "uncork", "Called without a matching cork()");
+        return;
+    }
+    if (--d->corkCount == 0)
+        d->corkStateChanged();
+}
+
+/*!
+    \since 6.7
+
+    Returns \c true if the device is corked.
+
+    \sa cork(), uncork()
+*/
+bool QIODevice::isCorked() const
+{
+    return d_func()->corkCount != 0;
+}
+
+void QIODevicePrivate::corkStateChanged()
+{
+}
+
 /*!
     Blocks until new data is available for reading and the readyRead()
     signal has been emitted, or until \a msecs milliseconds have
@@ -89,9 +89,14 @@ public:
     qint64 write(const char *data);
     qint64 write(const QByteArray &data);
 
+    void cork();
+    void uncork();
+    bool isCorked() const;
+
     qint64 peek(char *data, qint64 maxlen);
     QByteArray peek(qint64 maxlen);
     qint64 skip(qint64 maxSize);
+    qint64 transferTo(QIODevice *target, qint64 maxSize = -1);
 
     virtual bool waitForReadyRead(int msecs);
     virtual bool waitForBytesWritten(int msecs);
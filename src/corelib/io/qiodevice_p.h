@@ -45,6 +45,8 @@ public:
     QIODevicePrivate();
     virtual ~QIODevicePrivate();
 
+    static QIODevicePrivate *get(QIODevice *device) { return device->d_func(); }
+
     // The size of this class is a subject of the library hook data.
     // When adding a new member, do not make gaps and be aware
     // about the padding. Accordingly, adjust offsets in
@@ -66,6 +68,7 @@ public:
         inline qint64 nextDataBlockSize() const { return (m_buf ? m_buf->nextDataBlockSize() : Q_INT64_C(0)); }
         inline const char *readPointer() const { return (m_buf ? m_buf->readPointer() : nullptr); }
         inline const char *readPointerAtPosition(qint64 pos, qint64 &length) const { Q_ASSERT(m_buf); return m_buf->readPointerAtPosition(pos, length); }
+        inline qsizetype readPointers(QByteArrayView *blocks, qsizetype maxCount) const { return (m_buf ? m_buf->readPointers(blocks, maxCount) : 0); }
         inline void free(qint64 bytes) { Q_ASSERT(m_buf); m_buf->free(bytes); }
         inline char *reserve(qint64 bytes) { Q_ASSERT(m_buf); return m_buf->reserve(bytes); }
         inline char *reserveFront(qint64 bytes) { Q_ASSERT(m_buf); return m_buf->reserveFront(bytes); }
@@ -106,6 +109,7 @@ public:
 
     bool transactionStarted = false;
     bool baseReadLineDataCalled = false;
+    int corkCount = 0;
 
     virtual bool putCharHelper(char c);
 
@@ -149,6 +153,14 @@ public:
     virtual qint64 peek(char *data, qint64 maxSize);
     virtual QByteArray peek(qint64 maxSize);
     qint64 skipByReading(qint64 maxSize);
+    qint64 transferByCopying(QIODevice *target, qint64 maxSize);
+    // Descriptors used by QIODevice::transferTo() to move data without
+    // copying it through user space. Implementations must only return a
+    // valid descriptor if raw I/O on it is equivalent to read()/write().
+    virtual int transferSourceDescriptor();
+    virtual int transferTargetDescriptor();
+    // Called when the device becomes corked or uncorked.
+    virtual void corkStateChanged();
     void write(const char *data, qint64 size);
 
     inline bool isWriteChunkCached(const char *data, qint64 size) const
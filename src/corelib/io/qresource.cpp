@@ -11,6 +11,7 @@
 #include "qlocale.h"
 #include "qglobal.h"
 #include "qlist.h"
+#include "qhash.h"
 #include "qdatetime.h"
 #include "qbytearray.h"
 #include "qstringlist.h"
@@ -19,6 +20,7 @@
 #include <qplatformdefs.h>
 #include <qendian.h>
 #include "private/qabstractfileengine_p.h"
+#include "private/qbytearray_p.h"
 #include "private/qduplicatetracker_p.h"
 #include "private/qnumeric_p.h"
 #include "private/qsimd_p.h"
@@ -163,10 +165,17 @@ static QString cleanPath(const QString &_path)
 Q_DECLARE_TYPEINFO(QResourceRoot, Q_RELOCATABLE_TYPE);
 
 typedef QList<QResourceRoot*> ResourceList;
+// A root and the node found in it; -1 if the path is a parent of the
+// root's mapping root.
+typedef QList<std::pair<QResourceRoot *, int>> ResourceLookupResult;
 struct QResourceGlobalData
 {
     QRecursiveMutex resourceMutex;
     ResourceList resourceList;
+    // Remembers where a path was found in resourceList, and also where it
+    // was not found. Guarded by resourceMutex and cleared whenever
+    // resourceList changes, so the roots in it are always alive.
+    QHash<std::pair<QString, QLocale>, ResourceLookupResult> lookupCache;
 };
 Q_GLOBAL_STATIC(QResourceGlobalData, resourceGlobalData)
 
@@ -176,6 +185,10 @@ static inline QRecursiveMutex &resourceMutex()
 static inline ResourceList *resourceList()
 { return &resourceGlobalData->resourceList; }
 
+// Call with resourceMutex held after modifying resourceList.
+static inline void resourceListChanged()
+{ resourceGlobalData->lookupCache.clear(); }
+
 /*!
     \class QResource
     \inmodule QtCore
@@ -311,15 +324,40 @@ void QResourcePrivate::clear()
     related.clear();
 }
 
-bool QResourcePrivate::load(const QString &file)
+static ResourceLookupResult lookupResource(const QString &file, const QLocale &locale)
 {
-    related.clear();
-    const auto locker = qt_scoped_lock(resourceMutex());
+    constexpr qsizetype MaxLookupCacheSize = 1024;
+    auto &cache = resourceGlobalData->lookupCache;
+    const auto key = std::pair(file, locale);
+    if (const auto it = cache.constFind(key); it != cache.cend())
+        return *it;
+
+    ResourceLookupResult result;
     const ResourceList *list = resourceList();
-    QString cleaned = cleanPath(file);
+    const QString cleaned = cleanPath(file);
     for (int i = 0; i < list->size(); ++i) {
         QResourceRoot *res = list->at(i);
         const int node = res->findNode(cleaned, locale);
+        if (node != -1)
+            result.append({ res, node });
+        else if (res->mappingRootSubdir(file))
+            result.append({ res, -1 });
+    }
+
+    // Applications do not look up an unbounded number of different
+    // paths, but some do look up many once; start over then.
+    if (cache.size() >= MaxLookupCacheSize)
+        cache.clear();
+    cache.insert(key, result);
+    return result;
+}
+
+bool QResourcePrivate::load(const QString &file)
+{
+    related.clear();
+    const auto locker = qt_scoped_lock(resourceMutex());
+    const ResourceLookupResult found = lookupResource(file, locale);
+    for (const auto &[res, node] : found) {
         if (node != -1) {
             if (related.isEmpty()) {
                 container = res->isContainer(node);
@@ -338,7 +376,7 @@ bool QResourcePrivate::load(const QString &file)
             }
             res->ref.ref();
             related.append(res);
-        } else if (res->mappingRootSubdir(file)) {
+        } else {
             container = true;
             data = nullptr;
             size = 0;
@@ -1001,6 +1039,7 @@ Q_CORE_EXPORT bool qRegisterResourceData(int version, const unsigned char *tree,
             QResourceRoot *root = new QResourceRoot(version, tree, name, data);
             root->ref.ref();
             list->append(root);
+            resourceListChanged();
         }
         return true;
     }
@@ -1020,6 +1059,7 @@ Q_CORE_EXPORT bool qUnregisterResourceData(int version, const unsigned char *tre
         for (int i = 0; i < list->size();) {
             if (*list->at(i) == res) {
                 QResourceRoot *root = list->takeAt(i);
+                resourceListChanged();
                 if (!root->ref.deref())
                     delete root;
             } else {
@@ -1230,6 +1270,7 @@ bool QResource::registerResource(const QString &rccFilename, const QString &reso
         root->ref.ref();
         const auto locker = qt_scoped_lock(resourceMutex());
         resourceList()->append(root);
+        resourceListChanged();
         return true;
     }
     delete root;
@@ -1259,6 +1300,7 @@ bool QResource::unregisterResource(const QString &rccFilename, const QString &re
             QDynamicFileResourceRoot *root = reinterpret_cast<QDynamicFileResourceRoot *>(res);
             if (root->mappingFile() == rccFilename && root->mappingRoot() == r) {
                 list->removeAt(i);
+                resourceListChanged();
                 if (!root->ref.deref()) {
                     delete root;
                     return true;
@@ -1299,6 +1341,7 @@ bool QResource::registerResource(const uchar *rccData, const QString &resourceRo
         root->ref.ref();
         const auto locker = qt_scoped_lock(resourceMutex());
         resourceList()->append(root);
+        resourceListChanged();
         return true;
     }
     delete root;
@@ -1328,6 +1371,7 @@ bool QResource::unregisterResource(const uchar *rccData, const QString &resource
             QDynamicBufferResourceRoot *root = reinterpret_cast<QDynamicBufferResourceRoot *>(res);
             if (root->mappingBuffer() == rccData && root->mappingRoot() == r) {
                 list->removeAt(i);
+                resourceListChanged();
                 if (!root->ref.deref()) {
                     delete root;
                     return true;
@@ -1348,12 +1392,24 @@ protected:
 private:
     uchar *map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags);
     bool unmap(uchar *ptr);
-    void uncompress() const;
+    bool decompressUpTo(qint64 end);
+    void endDecompression();
     qint64 offset;
     QResource resource;
-    mutable QByteArray uncompressed;
+    // Holds the part of the resource decompressed so far. Compressed
+    // resources are inflated incrementally, as far as reads have needed,
+    // so that opening a large resource to read its header stays cheap.
+    QByteArray uncompressed;
+#ifndef QT_NO_COMPRESS
+    std::unique_ptr<z_stream> zlibStream;
+#endif
+#if QT_CONFIG(zstd)
+    ZSTD_DStream *zstdStream = nullptr;
+    size_t zstdInputPos = 0;
+#endif
 protected:
     QResourceFileEnginePrivate() : offset(0) { }
+    ~QResourceFileEnginePrivate() { endDecompression(); }
 };
 
 bool QResourceFileEngine::caseSensitive() const
@@ -1390,13 +1446,6 @@ bool QResourceFileEngine::open(QIODevice::OpenMode flags,
     }
     if (flags & QIODevice::WriteOnly)
         return false;
-    if (d->resource.compressionAlgorithm() != QResource::NoCompression) {
-        d->uncompress();
-        if (d->uncompressed.isNull()) {
-            d->errorString = QSystemError::stdString(EIO);
-            return false;
-        }
-    }
     if (!d->resource.isValid()) {
         d->errorString = QSystemError::stdString(ENOENT);
         return false;
@@ -1423,10 +1472,15 @@ qint64 QResourceFileEngine::read(char *data, qint64 len)
         len = size() - d->offset;
     if (len <= 0)
         return 0;
-    if (!d->uncompressed.isNull())
+    if (d->resource.compressionAlgorithm() != QResource::NoCompression) {
+        if (!d->decompressUpTo(d->offset + len)) {
+            setError(QFile::ReadError, QSystemError::stdString(EIO));
+            return -1;
+        }
         memcpy(data, d->uncompressed.constData() + d->offset, len);
-    else
+    } else {
         memcpy(data, d->resource.data() + d->offset, len);
+    }
     d->offset += len;
     return len;
 }
@@ -1584,9 +1638,12 @@ uchar *QResourceFileEnginePrivate::map(qint64 offset, qint64 size, QFile::Memory
 
     const uchar *address = resource.data();
     if (resource.compressionAlgorithm() != QResource::NoCompression) {
-        uncompress();
-        if (uncompressed.isNull())
+        // The mapping must stay valid, so inflate everything at once; the
+        // buffer is never reallocated after that.
+        if (!decompressUpTo(max)) {
+            q->setError(QFile::UnspecifiedError, QSystemError::stdString(EIO));
             return nullptr;
+        }
         address = reinterpret_cast<const uchar *>(uncompressed.constData());
     }
 
@@ -1599,12 +1656,112 @@ bool QResourceFileEnginePrivate::unmap(uchar *ptr)
     return true;
 }
 
-void QResourceFileEnginePrivate::uncompress() const
+bool QResourceFileEnginePrivate::decompressUpTo(qint64 end)
+{
+    if (uncompressed.size() >= end)
+        return true;
+
+    const qint64 total = resource.uncompressedSize();
+    if (total < 0 || total >= MaxByteArraySize || end > total)
+        return false;
+
+    // Don't decompress in tiny steps for small reads.
+    constexpr qint64 DecompressionStep = 64 * 1024;
+    end = qMin(total, qMax(end, uncompressed.size() + DecompressionStep));
+
+    // Reserving the full size keeps the already decompressed data in place
+    // and lets map() hand out pointers into the buffer. For large
+    // resources, the pages that were not decompressed yet are not touched.
+    if (uncompressed.isNull())
+        uncompressed.reserve(total);
+
+    const qsizetype have = uncompressed.size();
+    uncompressed.resize(end);
+    char *out = uncompressed.data() + have;
+    const size_t outLen = size_t(end - have);
+    size_t produced = 0;
+    const uchar *data = resource.data();
+    const qint64 size = resource.size();
+
+    switch (resource.compressionAlgorithm()) {
+    case QResource::NoCompression:
+        Q_UNREACHABLE();
+        break;
+
+    case QResource::ZlibCompression: {
+#ifndef QT_NO_COMPRESS
+        if (!zlibStream) {
+            if (size_t(size) < sizeof(quint32))
+                break;
+            zlibStream = std::make_unique<z_stream>();
+            memset(zlibStream.get(), 0, sizeof(z_stream));
+            // skip the big-endian size that rcc puts in front of the zlib stream
+            zlibStream->next_in = const_cast<Bytef *>(data + sizeof(quint32));
+            zlibStream->avail_in = uInt(size - sizeof(quint32));
+            if (inflateInit(zlibStream.get()) != Z_OK) {
+                zlibStream.reset();
+                break;
+            }
+        }
+        // The uncompressed size fits in a quint32, and so does outLen.
+        zlibStream->next_out = reinterpret_cast<Bytef *>(out);
+        zlibStream->avail_out = uInt(outLen);
+        const int res = inflate(zlibStream.get(), Z_SYNC_FLUSH);
+        if (res != Z_OK && res != Z_STREAM_END) {
+            qWarning("QResource: error decompressing zlib content (%d)", res);
+            break;
+        }
+        produced = outLen - zlibStream->avail_out;
+#endif
+        break;
+    }
+
+    case QResource::ZstdCompression: {
+#if QT_CONFIG(zstd)
+        if (!zstdStream) {
+            zstdStream = ZSTD_createDStream();
+            if (!zstdStream)
+                break;
+            ZSTD_initDStream(zstdStream);
+        }
+        ZSTD_inBuffer in = { data, size_t(size), zstdInputPos };
+        ZSTD_outBuffer outBuffer = { out, outLen, 0 };
+        while (outBuffer.pos < outBuffer.size) {
+            const size_t res = ZSTD_decompressStream(zstdStream, &outBuffer, &in);
+            if (ZSTD_isError(res)) {
+                qWarning("QResource: error decompressing zstd content: %s",
+                         ZSTD_getErrorName(res));
+                break;
+            }
+            if (res == 0 || in.pos == in.size)
+                break;
+        }
+        zstdInputPos = in.pos;
+        produced = outBuffer.pos;
+#endif
+        break;
+    }
+    }
+
+    uncompressed.truncate(have + produced);
+    if (uncompressed.size() == total)
+        endDecompression();
+    return produced == outLen;
+}
+
+void QResourceFileEnginePrivate::endDecompression()
 {
-    if (resource.compressionAlgorithm() == QResource::NoCompression
-            || !uncompressed.isEmpty() || resource.size() == 0)
-        return;     // nothing to do
-    uncompressed = resource.uncompressedData();
+#ifndef QT_NO_COMPRESS
+    if (zlibStream) {
+        inflateEnd(zlibStream.get());
+        zlibStream.reset();
+    }
+#endif
+#if QT_CONFIG(zstd)
+    ZSTD_freeDStream(zstdStream);
+    zstdStream = nullptr;
+    zstdInputPos = 0;
+#endif
 }
 
 #endif // !defined(QT_BOOTSTRAPPED)
@@ -32,6 +32,10 @@
 #include "qlockfile.h"
 #endif
 
+#if QT_CONFIG(thread)
+#include "qthreadpool.h"
+#endif
+
 #ifdef Q_OS_VXWORKS
 #  include <ioLib.h>
 #endif
@@ -100,6 +104,21 @@ Q_GLOBAL_STATIC(CustomFormatVector, customFormatVectorFunc)
 
 Q_CONSTINIT static QBasicMutex settingsGlobalMutex;
 
+#if QT_CONFIG(thread) && !defined(Q_OS_WASM)
+/*
+    A single writer thread, so that background flushes of the same file
+    happen in the order in which they were requested. The pool waits for
+    pending writes when it is destroyed at exit.
+*/
+namespace {
+struct QSettingsWriteBehindPool : QThreadPool
+{
+    QSettingsWriteBehindPool() { setMaxThreadCount(1); }
+};
+}
+Q_GLOBAL_STATIC(QSettingsWriteBehindPool, writeBehindPool)
+#endif
+
 Q_CONSTINIT static QSettings::Format globalDefaultFormat = QSettings::NativeFormat;
 
 QConfFile::QConfFile(const QString &fileName, bool _userPerms)
@@ -322,7 +341,8 @@ void QSettingsPrivate::setStatus(QSettings::Status status) const
 
 void QSettingsPrivate::update()
 {
-    flush();
+    if (!flushInBackground())
+        flush();
     pendingChanges = false;
 }
 
@@ -1127,37 +1147,43 @@ QConfFileSettingsPrivate::QConfFileSettingsPrivate(const QString &fileName,
     initAccess();
 }
 
-QConfFileSettingsPrivate::~QConfFileSettingsPrivate()
+// Drops a reference to conf_file; settingsGlobalMutex must be held.
+static void releaseConfFile(QConfFile *conf_file)
 {
-    const auto locker = qt_scoped_lock(settingsGlobalMutex);
+    if (conf_file->ref.deref())
+        return;
+
+    if (conf_file->size == 0) {
+        delete conf_file;
+        return;
+    }
+
     ConfFileHash *usedHash = usedHashFunc();
     ConfFileCache *unusedCache = unusedCacheFunc();
-
-    for (auto conf_file : std::as_const(confFiles)) {
-        if (!conf_file->ref.deref()) {
-            if (conf_file->size == 0) {
-                delete conf_file;
-            } else {
-                if (usedHash)
-                    usedHash->remove(conf_file->name);
-                if (unusedCache) {
-                    QT_TRY {
-                        // compute a better size?
-                        unusedCache->insert(conf_file->name, conf_file,
-                                            10 + (conf_file->originalKeys.size() / 4));
-                    } QT_CATCH(...) {
-                        // out of memory. Do not cache the file.
-                        delete conf_file;
-                    }
-                } else {
-                    // unusedCache is gone - delete the entry to prevent a memory leak
-                    delete conf_file;
-                }
-            }
+    if (usedHash)
+        usedHash->remove(conf_file->name);
+    if (unusedCache) {
+        QT_TRY {
+            // compute a better size?
+            unusedCache->insert(conf_file->name, conf_file,
+                                10 + (conf_file->originalKeys.size() / 4));
+        } QT_CATCH(...) {
+            // out of memory. Do not cache the file.
+            delete conf_file;
         }
+    } else {
+        // unusedCache is gone - delete the entry to prevent a memory leak
+        delete conf_file;
     }
 }
 
+QConfFileSettingsPrivate::~QConfFileSettingsPrivate()
+{
+    const auto locker = qt_scoped_lock(settingsGlobalMutex);
+    for (auto conf_file : std::as_const(confFiles))
+        releaseConfFile(conf_file);
+}
+
 void QConfFileSettingsPrivate::remove(const QString &key)
 {
     if (confFiles.isEmpty())
@@ -1298,6 +1324,43 @@ void QConfFileSettingsPrivate::flush()
     sync();
 }
 
+/*
+    With QT_SETTINGS_WRITE_BEHIND set, the implicit flushes (the deferred
+    update and the one done by ~QSettings) are handed to a background thread
+    instead of blocking the caller on the lock file and the write.
+
+    Only the first conf file can have pending changes. The job keeps a
+    reference on it, so QSettings objects opened on the same file meanwhile
+    share it and see the pending changes; their own sync() writes them
+    synchronously. Errors of a background write are not reported.
+*/
+bool QConfFileSettingsPrivate::flushInBackground()
+{
+#if QT_CONFIG(thread) && !defined(Q_OS_WASM)
+    if (confFiles.isEmpty() || !qEnvironmentVariableIntValue("QT_SETTINGS_WRITE_BEHIND"))
+        return false;
+
+    QThreadPool *pool = writeBehindPool();
+    if (!pool)
+        return false;
+
+    QConfFile *confFile = confFiles.at(0);
+    confFile->ref.ref();
+    pool->start([confFile, format = format, atomicSyncOnly = atomicSyncOnly] {
+        {
+            QSettings settings(confFile->name, format);
+            settings.setAtomicSyncRequired(atomicSyncOnly);
+            settings.sync();
+        }
+        const auto locker = qt_scoped_lock(settingsGlobalMutex);
+        releaseConfFile(confFile);
+    });
+    return true;
+#else
+    return false;
+#endif
+}
+
 QString QConfFileSettingsPrivate::fileName() const
 {
     if (confFiles.isEmpty())
@@ -2696,7 +2759,8 @@ QSettings::~QSettings()
         // Don't cause a failing flush() to std::terminate() the whole
         // application - dtors are implicitly noexcept!
         QT_TRY {
-            d->flush();
+            if (!d->flushInBackground())
+                d->flush();
         } QT_CATCH(...) {
         }
     }
@@ -2729,6 +2793,13 @@ void QSettings::clear()
     by the event loop at regular intervals, so you normally don't need to
     call it yourself.
 
+    Since Qt 6.7, when the environment variable \c QT_SETTINGS_WRITE_BEHIND
+    is set to \c 1, the automatic writes of INI-based and custom formats
+    are performed on a background thread instead. Other QSettings objects
+    accessing the same file in the same process see the unsaved changes
+    meanwhile. Calling sync() explicitly still writes synchronously, and is
+    the only way to learn about errors via status().
+
     \sa status()
 */
 void QSettings::sync()
@@ -170,6 +170,7 @@ public:
     virtual void clear() = 0;
     virtual void sync() = 0;
     virtual void flush() = 0;
+    virtual bool flushInBackground() { return false; }
     virtual bool isWritable() const = 0;
     virtual QString fileName() const = 0;
 
@@ -233,6 +234,7 @@ public:
     void clear() override;
     void sync() override;
     void flush() override;
+    bool flushInBackground() override;
     bool isWritable() const override;
     QString fileName() const override;
 
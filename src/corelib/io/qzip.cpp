@@ -8,14 +8,25 @@
 #include <qendian.h>
 #include <qdebug.h>
 #include <qdir.h>
+#include <qscopeguard.h>
 
+#if QT_CONFIG(future) && QT_CONFIG(thread)
+#include <qfuture.h>
+#include <qpromise.h>
+#include <qthreadpool.h>
+#endif
+
+#include <deque>
 #include <memory>
+#include <optional>
 
 #include <zlib.h>
 
 // Zip standard version for archives handled by this API
 // (actually, the only basic support of this version is implemented but it is enough for now)
 #define ZIP_VERSION 20
+// Version needed to extract entries that use the zip64 extensions
+#define ZIP64_VERSION 45
 
 #if 0
 #define ZDEBUG qDebug
@@ -35,6 +46,11 @@ static inline ushort readUShort(const uchar *data)
     return (data[0]) + (data[1]<<8);
 }
 
+static inline quint64 readULongLong(const uchar *data)
+{
+    return qFromLittleEndian<quint64>(data);
+}
+
 static inline void writeUInt(uchar *data, uint i)
 {
     data[0] = i & 0xff;
@@ -49,6 +65,11 @@ static inline void writeUShort(uchar *data, ushort i)
     data[1] = (i>>8) & 0xff;
 }
 
+static inline void writeULongLong(uchar *data, quint64 i)
+{
+    qToLittleEndian(i, data);
+}
+
 static inline void copyUInt(uchar *dest, const uchar *src)
 {
     dest[0] = src[0];
@@ -89,70 +110,75 @@ static void writeMSDosDate(uchar *dest, const QDateTime& dt)
     }
 }
 
-static int inflate(Bytef *dest, ulong *destLen, const Bytef *source, ulong sourceLen)
+// size of the buffers used when streaming entry data
+static constexpr qsizetype ChunkSize = 64 * 1024;
+
+// sizes and offsets from this value on are stored in zip64 extra fields
+static constexpr quint64 Zip64Limit = 0xffffffff;
+static constexpr ushort Zip64ExtraFieldId = 0x0001;
+
+static uint updateCrc(uint crc, const char *data, qsizetype len)
 {
-    z_stream stream;
-    int err;
-
-    stream.next_in = const_cast<Bytef*>(source);
-    stream.avail_in = (uInt)sourceLen;
-    if ((uLong)stream.avail_in != sourceLen)
-        return Z_BUF_ERROR;
-
-    stream.next_out = dest;
-    stream.avail_out = (uInt)*destLen;
-    if ((uLong)stream.avail_out != *destLen)
-        return Z_BUF_ERROR;
-
-    stream.zalloc = (alloc_func)nullptr;
-    stream.zfree = (free_func)nullptr;
-
-    err = inflateInit2(&stream, -MAX_WBITS);
-    if (err != Z_OK)
-        return err;
-
-    err = inflate(&stream, Z_FINISH);
-    if (err != Z_STREAM_END) {
-        inflateEnd(&stream);
-        if (err == Z_NEED_DICT || (err == Z_BUF_ERROR && stream.avail_in == 0))
-            return Z_DATA_ERROR;
-        return err;
+    while (len > 0) {
+        const uInt chunk = uInt(qMin(len, qsizetype(1) << 30));
+        crc = ::crc32(crc, reinterpret_cast<const Bytef *>(data), chunk);
+        data += chunk;
+        len -= chunk;
     }
-    *destLen = stream.total_out;
-
-    err = inflateEnd(&stream);
-    return err;
+    return crc;
 }
 
-static int deflate (Bytef *dest, ulong *destLen, const Bytef *source, ulong sourceLen)
+namespace {
+// Raw deflate (no zlib header) of data that is fed in pieces.
+class RawDeflater
 {
-    z_stream stream;
-    int err;
-
-    stream.next_in = const_cast<Bytef*>(source);
-    stream.avail_in = (uInt)sourceLen;
-    stream.next_out = dest;
-    stream.avail_out = (uInt)*destLen;
-    if ((uLong)stream.avail_out != *destLen) return Z_BUF_ERROR;
-
-    stream.zalloc = (alloc_func)nullptr;
-    stream.zfree = (free_func)nullptr;
-    stream.opaque = (voidpf)nullptr;
+public:
+    RawDeflater()
+    {
+        memset(&stream, 0, sizeof(stream));
+        valid = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                             Z_DEFAULT_STRATEGY) == Z_OK;
+    }
+    ~RawDeflater()
+    {
+        if (valid)
+            deflateEnd(&stream);
+    }
+    Q_DISABLE_COPY_MOVE(RawDeflater)
 
-    err = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
-    if (err != Z_OK) return err;
+    bool isValid() const { return valid; }
 
-    err = deflate(&stream, Z_FINISH);
-    if (err != Z_STREAM_END) {
-        deflateEnd(&stream);
-        return err == Z_OK ? Z_BUF_ERROR : err;
+    // Compresses \a data and passes the output to \a sink, which returns
+    // false to abort. With \a finish, the end of the stream is written too.
+    template <typename Sink>
+    bool process(const char *data, qsizetype len, bool finish, Sink &&sink)
+    {
+        Bytef out[ChunkSize];
+        do {
+            const uInt chunk = uInt(qMin(len, qsizetype(1) << 30));
+            stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+            stream.avail_in = chunk;
+            data += chunk;
+            len -= chunk;
+            const int flush = (finish && len == 0) ? Z_FINISH : Z_NO_FLUSH;
+            do {
+                stream.next_out = out;
+                stream.avail_out = sizeof(out);
+                if (::deflate(&stream, flush) == Z_STREAM_ERROR)
+                    return false;
+                const qsizetype produced = qsizetype(sizeof(out)) - stream.avail_out;
+                if (produced && !sink(reinterpret_cast<const char *>(out), produced))
+                    return false;
+            } while (stream.avail_out == 0);
+        } while (len > 0);
+        return true;
     }
-    *destLen = stream.total_out;
-
-    err = deflateEnd(&stream);
-    return err;
-}
 
+private:
+    z_stream stream;
+    bool valid;
+};
+} // unnamed namespace
 
 namespace WindowsFileAttributes {
 enum {
@@ -357,6 +383,30 @@ struct CentralFileHeader
 };
 Q_DECLARE_TYPEINFO(CentralFileHeader, Q_PRIMITIVE_TYPE);
 
+struct Zip64EndOfDirectoryLocator
+{
+    uchar signature[4]; // 0x07064b50
+    uchar start_of_directory_disk[4];
+    uchar eod_offset[8];
+    uchar total_disks[4];
+};
+Q_DECLARE_TYPEINFO(Zip64EndOfDirectoryLocator, Q_PRIMITIVE_TYPE);
+
+struct Zip64EndOfDirectory
+{
+    uchar signature[4]; // 0x06064b50
+    uchar record_size[8];
+    uchar version_made[2];
+    uchar version_needed[2];
+    uchar this_disk[4];
+    uchar start_of_directory_disk[4];
+    uchar num_dir_entries_this_disk[8];
+    uchar num_dir_entries[8];
+    uchar directory_size[8];
+    uchar dir_start_offset[8];
+};
+Q_DECLARE_TYPEINFO(Zip64EndOfDirectory, Q_PRIMITIVE_TYPE);
+
 struct EndOfDirectory
 {
     uchar signature[4]; // 0x06054b50
@@ -376,6 +426,10 @@ struct FileHeader
     QByteArray file_name;
     QByteArray extra_field;
     QByteArray file_comment;
+    // the values of h, or of its zip64 extra field where they don't fit
+    qint64 compressedSize = 0;
+    qint64 uncompressedSize = 0;
+    qint64 localHeaderOffset = 0;
 };
 Q_DECLARE_TYPEINFO(FileHeader, Q_RELOCATABLE_TYPE);
 
@@ -400,13 +454,66 @@ public:
     bool dirtyFileTree;
     QList<FileHeader> fileHeaders;
     QByteArray comment;
-    uint start_of_directory;
+    qint64 start_of_directory;
 };
 
+// Returns a zip64 extended information extra field holding \a values.
+static QByteArray zip64ExtraField(const quint64 *values, int count)
+{
+    QByteArray field(4 + 8 * count, Qt::Uninitialized);
+    uchar *data = reinterpret_cast<uchar *>(field.data());
+    writeUShort(data, Zip64ExtraFieldId);
+    writeUShort(data + 2, ushort(8 * count));
+    for (int i = 0; i < count; ++i)
+        writeULongLong(data + 4 + 8 * i, values[i]);
+    return field;
+}
+
+// Resolves the sizes and offset of \a header, which are only present in the
+// zip64 extra field if the corresponding field of the header is 0xffffffff.
+static bool resolveZip64Fields(FileHeader &header)
+{
+    header.uncompressedSize = readUInt(header.h.uncompressed_size);
+    header.compressedSize = readUInt(header.h.compressed_size);
+    header.localHeaderOffset = readUInt(header.h.offset_local_header);
+    if (header.uncompressedSize != Zip64Limit && header.compressedSize != Zip64Limit
+        && header.localHeaderOffset != qint64(Zip64Limit)) {
+        return true;
+    }
+
+    const uchar *extra = reinterpret_cast<const uchar *>(header.extra_field.constData());
+    qsizetype remaining = header.extra_field.size();
+    while (remaining >= 4) {
+        const ushort id = readUShort(extra);
+        const ushort size = readUShort(extra + 2);
+        if (size > remaining - 4)
+            break;
+        if (id == Zip64ExtraFieldId) {
+            const uchar *value = extra + 4;
+            const uchar *end = value + size;
+            for (qint64 *field : { &header.uncompressedSize, &header.compressedSize,
+                                   &header.localHeaderOffset }) {
+                if (*field != qint64(Zip64Limit))
+                    continue;
+                if (end - value < 8)
+                    return false;
+                *field = qint64(readULongLong(value));
+                if (*field < 0)
+                    return false;
+                value += 8;
+            }
+            return true;
+        }
+        extra += 4 + size;
+        remaining -= 4 + size;
+    }
+    return false;
+}
+
 QZipReader::FileInfo QZipPrivate::fillFileInfo(int index) const
 {
     QZipReader::FileInfo fileInfo;
-    FileHeader header = fileHeaders.at(index);
+    const FileHeader &header = fileHeaders.at(index);
     quint32 mode = readUInt(header.h.external_file_attributes);
     const HostOS hostOS = HostOS(readUShort(header.h.version_made) >> 8);
     switch (hostOS) {
@@ -455,7 +562,7 @@ QZipReader::FileInfo QZipPrivate::fillFileInfo(int index) const
     const bool inUtf8 = (general_purpose_bits & Utf8Names) != 0;
     fileInfo.filePath = inUtf8 ? QString::fromUtf8(header.file_name) : QString::fromLocal8Bit(header.file_name);
     fileInfo.crc = readUInt(header.h.crc_32);
-    fileInfo.size = readUInt(header.h.uncompressed_size);
+    fileInfo.size = header.uncompressedSize;
     fileInfo.lastModified = readMSDosDate(header.h.last_mod_file);
 
     // fix the file path, if broken (convert separators, eat leading and trailing ones)
@@ -479,6 +586,9 @@ public:
     }
 
     void scanFiles();
+    int entryIndex(const QString &fileName);
+    template <typename Sink>
+    bool readEntryData(int index, Sink &&sink);
 
     QZipReader::Status status;
 };
@@ -500,7 +610,38 @@ public:
 
     enum EntryType { Directory, File, Symlink };
 
+    struct CompressedData
+    {
+        QByteArray data;
+        qint64 uncompressedSize = 0;
+        uint crc = 0;
+        ushort compressionMethod = CompressionMethodStored;
+    };
+
     void addEntry(EntryType type, const QString &fileName, const QByteArray &contents);
+    void addStreamedEntry(const QString &fileName, QIODevice *source);
+    void writePendingEntries(qsizetype maxPending);
+
+private:
+    bool openDevice();
+    FileHeader makeHeader(EntryType type, const QString &fileName) const;
+    void writeEntry(FileHeader &header, const CompressedData &data);
+    bool writeLocalHeader(const FileHeader &header, bool zip64);
+    void setEntrySizes(FileHeader &header, uint crc, bool zip64);
+    static CompressedData compress(const QByteArray &contents,
+                                   QZipWriter::CompressionPolicy policy);
+
+#if QT_CONFIG(future) && QT_CONFIG(thread)
+    // Entries whose contents are being compressed on compressionPool; they
+    // are written in the order in which they were added.
+    struct PendingEntry
+    {
+        FileHeader header;
+        QFuture<CompressedData> data;
+    };
+    std::deque<PendingEntry> pendingEntries;
+    std::unique_ptr<QThreadPool> compressionPool;
+#endif
 };
 
 static LocalFileHeader toLocalHeader(const CentralFileHeader &ch)
@@ -544,11 +685,10 @@ void QZipReaderPrivate::scanFiles()
 
     // find EndOfDirectory header
     int i = 0;
-    int start_of_directory = -1;
-    int num_dir_entries = 0;
+    qint64 eod_pos = -1;
     EndOfDirectory eod;
-    while (start_of_directory == -1) {
-        const int pos = device->size() - int(sizeof(EndOfDirectory)) - i;
+    while (eod_pos == -1) {
+        const qint64 pos = device->size() - qint64(sizeof(EndOfDirectory)) - i;
         if (pos < 0 || i > 65535) {
             qWarning("QZip: EndOfDirectory not found");
             return;
@@ -557,22 +697,44 @@ void QZipReaderPrivate::scanFiles()
         device->seek(pos);
         device->read((char *)&eod, sizeof(EndOfDirectory));
         if (readUInt(eod.signature) == 0x06054b50)
-            break;
-        ++i;
+            eod_pos = pos;
+        else
+            ++i;
     }
 
     // have the eod
-    start_of_directory = readUInt(eod.dir_start_offset);
-    num_dir_entries = readUShort(eod.num_dir_entries);
-    ZDEBUG("start_of_directory at %d, num_dir_entries=%d", start_of_directory, num_dir_entries);
+    qint64 start_of_directory = readUInt(eod.dir_start_offset);
+    qint64 num_dir_entries = readUShort(eod.num_dir_entries);
     int comment_length = readUShort(eod.comment_length);
     if (comment_length != i)
         qWarning("QZip: failed to parse zip file.");
     comment = device->read(qMin(comment_length, i));
 
+    // zip64 archives keep the real values in a record found through a
+    // locator that precedes the EndOfDirectory
+    Zip64EndOfDirectoryLocator locator;
+    if (eod_pos >= qint64(sizeof(locator)) && device->seek(eod_pos - qint64(sizeof(locator)))
+        && device->read((char *)&locator, sizeof(locator)) == qint64(sizeof(locator))
+        && readUInt(locator.signature) == 0x07064b50) {
+        Zip64EndOfDirectory eod64;
+        const qint64 eod64_pos = qint64(readULongLong(locator.eod_offset));
+        if (eod64_pos < 0 || !device->seek(eod64_pos)
+            || device->read((char *)&eod64, sizeof(eod64)) != qint64(sizeof(eod64))
+            || readUInt(eod64.signature) != 0x06064b50) {
+            qWarning("QZip: Zip64 EndOfDirectory not found");
+            return;
+        }
+        start_of_directory = qint64(readULongLong(eod64.dir_start_offset));
+        num_dir_entries = qint64(readULongLong(eod64.num_dir_entries));
+        if (start_of_directory < 0 || num_dir_entries < 0) {
+            qWarning("QZip: failed to parse zip file.");
+            return;
+        }
+    }
+    ZDEBUG("start_of_directory at %lld, num_dir_entries=%lld", start_of_directory, num_dir_entries);
 
     device->seek(start_of_directory);
-    for (i = 0; i < num_dir_entries; ++i) {
+    for (qint64 n = 0; n < num_dir_entries; ++n) {
         FileHeader header;
         int read = device->read((char *) &header.h, sizeof(CentralFileHeader));
         if (read < (int)sizeof(CentralFileHeader)) {
@@ -602,75 +764,138 @@ void QZipReaderPrivate::scanFiles()
             qWarning("QZip: Failed to read read file comment, index may be incomplete");
             break;
         }
+        if (!resolveZip64Fields(header)) {
+            qWarning("QZip: Invalid zip64 extra field, index may be incomplete");
+            break;
+        }
 
         ZDEBUG("found file '%s'", header.file_name.data());
         fileHeaders.append(header);
     }
 }
 
-void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
+int QZipReaderPrivate::entryIndex(const QString &fileName)
 {
-#ifndef NDEBUG
-    static const char *const entryTypes[] = {
-        "directory",
-        "file     ",
-        "symlink  " };
-    ZDEBUG() << "adding" << entryTypes[type] <<":" << fileName.toUtf8().data() << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
-#endif
+    scanFiles();
+    for (int i = 0; i < fileHeaders.size(); ++i) {
+        if (QString::fromLocal8Bit(fileHeaders.at(i).file_name) == fileName)
+            return i;
+    }
+    return -1;
+}
 
-    if (! (device->isOpen() || device->open(QIODevice::WriteOnly))) {
-        status = QZipWriter::FileOpenError;
-        return;
+/*
+    Reads the contents of the entry at \a index, passing them in chunks to
+    \a sink, which returns false to abort. Returns false if the entry can't
+    be extracted, or if its data is truncated or corrupt.
+*/
+template <typename Sink>
+bool QZipReaderPrivate::readEntryData(int index, Sink &&sink)
+{
+    const FileHeader &header = fileHeaders.at(index);
+
+    ushort version_needed = readUShort(header.h.version_needed);
+    if (version_needed > ZIP64_VERSION) {
+        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+        return false;
     }
-    device->seek(start_of_directory);
 
-    // don't compress small files
-    QZipWriter::CompressionPolicy compression = compressionPolicy;
-    if (compressionPolicy == QZipWriter::AutoCompress) {
-        if (contents.size() < 64)
-            compression = QZipWriter::NeverCompress;
-        else
-            compression = QZipWriter::AlwaysCompress;
+    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
+    if ((general_purpose_bits & Encrypted) != 0) {
+        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+        return false;
+    }
+
+    device->seek(header.localHeaderOffset);
+    LocalFileHeader lh;
+    if (device->read((char *)&lh, sizeof(LocalFileHeader)) != qint64(sizeof(LocalFileHeader)))
+        return false;
+    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+    device->seek(device->pos() + skip);
+
+    int compression_method = readUShort(lh.compression_method);
+    const auto bufferStorage = std::make_unique<char[]>(ChunkSize);
+    char *buffer = bufferStorage.get();
+
+    if (compression_method == CompressionMethodStored) {
+        qint64 remaining = qMin(header.compressedSize, header.uncompressedSize);
+        while (remaining > 0) {
+            const qint64 read = device->read(buffer, qMin(remaining, qint64(ChunkSize)));
+            if (read <= 0 || !sink(buffer, read))
+                return false;
+            remaining -= read;
+        }
+        return true;
+    }
+
+    if (compression_method == CompressionMethodDeflated) {
+        z_stream stream;
+        memset(&stream, 0, sizeof(stream));
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+            qWarning("QZip: Z_MEM_ERROR: Not enough memory");
+            return false;
+        }
+        auto cleanup = qScopeGuard([&stream] { inflateEnd(&stream); });
+
+        Bytef out[ChunkSize];
+        qint64 remaining = header.compressedSize;
+        for (;;) {
+            if (stream.avail_in == 0 && remaining > 0) {
+                const qint64 read = device->read(buffer, qMin(remaining, qint64(ChunkSize)));
+                if (read <= 0) {
+                    qWarning("QZip: Failed to read compressed data");
+                    return false;
+                }
+                remaining -= read;
+                stream.next_in = reinterpret_cast<Bytef *>(buffer);
+                stream.avail_in = uInt(read);
+            }
+            stream.next_out = out;
+            stream.avail_out = sizeof(out);
+            int res = inflate(&stream, Z_NO_FLUSH);
+            const qint64 produced = qint64(sizeof(out)) - stream.avail_out;
+            if (produced && !sink(reinterpret_cast<const char *>(out), produced))
+                return false;
+            if (res == Z_STREAM_END)
+                return true;
+            // no progress is possible without more input, and there is none
+            if (res == Z_BUF_ERROR && stream.avail_in == 0 && remaining == 0)
+                res = Z_DATA_ERROR;
+            if (res != Z_OK && res != Z_BUF_ERROR) {
+                if (res == Z_MEM_ERROR)
+                    qWarning("QZip: Z_MEM_ERROR: Not enough memory");
+                else
+                    qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
+                return false;
+            }
+        }
+    }
+
+    qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
+    return false;
+}
+
+bool QZipWriterPrivate::openDevice()
+{
+    if (! (device->isOpen() || device->open(QIODevice::WriteOnly))) {
+        status = QZipWriter::FileOpenError;
+        return false;
     }
+    return true;
+}
 
+/*
+    Returns the central directory header of a new entry, without the
+    fields that depend on its contents and position.
+*/
+FileHeader QZipWriterPrivate::makeHeader(EntryType type, const QString &fileName) const
+{
     FileHeader header;
     memset(&header.h, 0, sizeof(CentralFileHeader));
     writeUInt(header.h.signature, 0x02014b50);
 
     writeUShort(header.h.version_needed, ZIP_VERSION);
-    writeUInt(header.h.uncompressed_size, contents.size());
     writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
-    QByteArray data = contents;
-    if (compression == QZipWriter::AlwaysCompress) {
-        writeUShort(header.h.compression_method, CompressionMethodDeflated);
-
-       ulong len = contents.size();
-        // shamelessly copied form zlib
-        len += (len >> 12) + (len >> 14) + 11;
-        int res;
-        do {
-            data.resize(len);
-            res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.size());
-
-            switch (res) {
-            case Z_OK:
-                data.resize(len);
-                break;
-            case Z_MEM_ERROR:
-                qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
-    }
-// TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
-    writeUInt(header.h.compressed_size, data.size());
-    uint crc_32 = ::crc32(0, nullptr, 0);
-    crc_32 = ::crc32(crc_32, (const uchar *)contents.constData(), contents.size());
-    writeUInt(header.h.crc_32, crc_32);
 
     // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
     ushort general_purpose_bits = Utf8Names; // always use utf-8
@@ -687,7 +912,6 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
         header.file_comment.truncate(0xffff - header.file_name.size()); // ### don't break the utf-8 sequence, if any
     }
     writeUShort(header.h.file_name_length, header.file_name.size());
-    //h.extra_field_length[2];
 
     writeUShort(header.h.version_made, HostUnix << 8);
     //uchar internal_file_attributes[2];
@@ -708,19 +932,277 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
         break;
     }
     writeUInt(header.h.external_file_attributes, mode << 16);
-    writeUInt(header.h.offset_local_header, start_of_directory);
-
+    return header;
+}
 
-    fileHeaders.append(header);
+/*
+    Stores the crc and the sizes and offset of \a header in the central
+    directory header, moving the values that don't fit into a zip64 extra
+    field. \a zip64 tells whether the local header used zip64 already.
+*/
+void QZipWriterPrivate::setEntrySizes(FileHeader &header, uint crc, bool zip64)
+{
+    writeUInt(header.h.crc_32, crc);
+
+    quint64 values[3];
+    int count = 0;
+    auto store = [&](uchar *field, qint64 value) {
+        if (quint64(value) >= Zip64Limit) {
+            writeUInt(field, Zip64Limit);
+            values[count++] = quint64(value);
+        } else {
+            writeUInt(field, uint(value));
+        }
+    };
+    store(header.h.uncompressed_size, header.uncompressedSize);
+    store(header.h.compressed_size, header.compressedSize);
+    store(header.h.offset_local_header, header.localHeaderOffset);
+
+    header.extra_field = count ? zip64ExtraField(values, count) : QByteArray();
+    writeUShort(header.h.extra_field_length, header.extra_field.size());
+    if (count || zip64)
+        writeUShort(header.h.version_needed, ZIP64_VERSION);
+}
 
+/*
+    Writes the local header of \a header at the current position. A zip64
+    local header carries both sizes in its extra field.
+*/
+bool QZipWriterPrivate::writeLocalHeader(const FileHeader &header, bool zip64)
+{
     LocalFileHeader h = toLocalHeader(header.h);
-    device->write((const char *)&h, sizeof(LocalFileHeader));
-    device->write(header.file_name);
-    device->write(data);
+    QByteArray extra;
+    if (zip64) {
+        writeUShort(h.version_needed, ZIP64_VERSION);
+        writeUInt(h.uncompressed_size, Zip64Limit);
+        writeUInt(h.compressed_size, Zip64Limit);
+        const quint64 sizes[] = { quint64(header.uncompressedSize),
+                                  quint64(header.compressedSize) };
+        extra = zip64ExtraField(sizes, 2);
+    }
+    writeUShort(h.extra_field_length, extra.size());
+
+    return device->write((const char *)&h, sizeof(LocalFileHeader)) == qint64(sizeof(LocalFileHeader))
+            && device->write(header.file_name) == header.file_name.size()
+            && device->write(extra) == extra.size();
+}
+
+QZipWriterPrivate::CompressedData
+QZipWriterPrivate::compress(const QByteArray &contents, QZipWriter::CompressionPolicy policy)
+{
+    CompressedData result;
+    result.uncompressedSize = contents.size();
+    result.crc = updateCrc(::crc32(0, nullptr, 0), contents.constData(), contents.size());
+
+    // don't compress small files
+    QZipWriter::CompressionPolicy compression = policy;
+    if (policy == QZipWriter::AutoCompress) {
+        if (contents.size() < 64)
+            compression = QZipWriter::NeverCompress;
+        else
+            compression = QZipWriter::AlwaysCompress;
+    }
+
+    if (compression == QZipWriter::AlwaysCompress) {
+        QByteArray data;
+        data.reserve(contents.size() / 2 + 64);
+        RawDeflater deflater;
+        const bool ok = deflater.isValid()
+                && deflater.process(contents.constData(), contents.size(), true,
+                                    [&data](const char *chunk, qsizetype len) {
+                                        data.append(chunk, len);
+                                        return true;
+                                    });
+        if (!ok) {
+            qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, storing it");
+        } else if (policy != QZipWriter::AutoCompress || data.size() < contents.size()) {
+            result.data = std::move(data);
+            result.compressionMethod = CompressionMethodDeflated;
+            return result;
+        }
+    }
+
+    result.data = contents;
+    return result;
+}
+
+void QZipWriterPrivate::writeEntry(FileHeader &header, const CompressedData &data)
+{
+    writeUShort(header.h.compression_method, data.compressionMethod);
+    header.uncompressedSize = data.uncompressedSize;
+    header.compressedSize = data.data.size();
+    header.localHeaderOffset = start_of_directory;
+    const bool zip64 = quint64(header.uncompressedSize) >= Zip64Limit
+            || quint64(header.compressedSize) >= Zip64Limit;
+    setEntrySizes(header, data.crc, zip64);
+
+    device->seek(start_of_directory);
+    if (!writeLocalHeader(header, zip64) || device->write(data.data) != data.data.size())
+        status = QZipWriter::FileWriteError;
+    fileHeaders.append(header);
     start_of_directory = device->pos();
     dirtyFileTree = true;
 }
 
+/*
+    Writes the entries at the front of the queue whose compression is done,
+    then waits until no more than \a maxPending entries remain queued.
+*/
+void QZipWriterPrivate::writePendingEntries(qsizetype maxPending)
+{
+#if QT_CONFIG(future) && QT_CONFIG(thread)
+    while (!pendingEntries.empty()) {
+        PendingEntry &entry = pendingEntries.front();
+        if (!entry.data.isFinished() && qsizetype(pendingEntries.size()) <= maxPending)
+            break;
+        writeEntry(entry.header, entry.data.takeResult());
+        pendingEntries.pop_front();
+    }
+#else
+    Q_UNUSED(maxPending);
+#endif
+}
+
+void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
+{
+#ifndef NDEBUG
+    static const char *const entryTypes[] = {
+        "directory",
+        "file     ",
+        "symlink  " };
+    ZDEBUG() << "adding" << entryTypes[type] <<":" << fileName.toUtf8().data() << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
+#endif
+
+    if (!openDevice())
+        return;
+
+    FileHeader header = makeHeader(type, fileName);
+
+#if QT_CONFIG(future) && QT_CONFIG(thread)
+    // Compress large entries in parallel; they are written out in order
+    // once done, keeping a bounded number of them in memory.
+    constexpr qsizetype ParallelCompressionThreshold = 256 * 1024;
+    if (contents.size() >= ParallelCompressionThreshold
+        && compressionPolicy != QZipWriter::NeverCompress) {
+        if (!compressionPool)
+            compressionPool = std::make_unique<QThreadPool>();
+        QPromise<CompressedData> promise;
+        QFuture<CompressedData> future = promise.future();
+        promise.start();
+        compressionPool->start([promise = std::move(promise), contents,
+                                policy = compressionPolicy]() mutable {
+            promise.addResult(compress(contents, policy));
+            promise.finish();
+        });
+        pendingEntries.push_back({ std::move(header), std::move(future) });
+        writePendingEntries(2 * qsizetype(compressionPool->maxThreadCount()));
+        return;
+    }
+    writePendingEntries(0);
+#endif
+
+    writeEntry(header, compress(contents, compressionPolicy));
+}
+
+/*
+    Adds a file entry whose contents are read from \a source in chunks, so
+    that it never has to be held in memory. The local header is written
+    first and patched once the sizes and the crc are known.
+*/
+void QZipWriterPrivate::addStreamedEntry(const QString &fileName, QIODevice *source)
+{
+    if (!openDevice())
+        return;
+    writePendingEntries(0);
+
+    FileHeader header = makeHeader(File, fileName);
+    const qint64 expectedSize = source->isSequential() ? -1 : source->size() - source->pos();
+
+    QZipWriter::CompressionPolicy compression = compressionPolicy;
+    if (compression == QZipWriter::AutoCompress) {
+        if (expectedSize >= 0 && expectedSize < 64)
+            compression = QZipWriter::NeverCompress;
+        else
+            compression = QZipWriter::AlwaysCompress;
+    }
+    std::optional<RawDeflater> deflater;
+    if (compression == QZipWriter::AlwaysCompress) {
+        deflater.emplace();
+        if (!deflater->isValid()) {
+            qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, storing it");
+            deflater.reset();
+        }
+    }
+    writeUShort(header.h.compression_method,
+                deflater ? CompressionMethodDeflated : CompressionMethodStored);
+
+    // The local header can't grow once the data follows it, so reserve the
+    // zip64 sizes unless the entry is known to fit. The margin leaves room
+    // for deflate's worst-case expansion.
+    const bool zip64 = expectedSize < 0 || expectedSize >= qint64(Zip64Limit - (Zip64Limit >> 4));
+
+    header.localHeaderOffset = start_of_directory;
+    device->seek(start_of_directory);
+    if (!writeLocalHeader(header, zip64)) {
+        status = QZipWriter::FileWriteError;
+        return;
+    }
+    const qint64 dataStart = device->pos();
+
+    uint crc = ::crc32(0, nullptr, 0);
+    bool ok = true;
+    auto writeData = [this, &ok](const char *data, qsizetype len) {
+        ok = device->write(data, len) == len;
+        return ok;
+    };
+    const auto buffer = std::make_unique<char[]>(ChunkSize);
+    for (;;) {
+        const qint64 read = source->read(buffer.get(), ChunkSize);
+        if (read < 0) {
+            status = QZipWriter::FileError;
+            ok = false;
+            break;
+        }
+        if (read == 0)
+            break;
+        crc = updateCrc(crc, buffer.get(), read);
+        header.uncompressedSize += read;
+        if (deflater ? !deflater->process(buffer.get(), read, false, writeData)
+                     : !writeData(buffer.get(), read)) {
+            ok = false;
+            break;
+        }
+    }
+    if (ok && deflater)
+        ok = deflater->process(nullptr, 0, true, writeData);
+    if (!ok) {
+        if (status == QZipWriter::NoError)
+            status = QZipWriter::FileWriteError;
+        device->seek(start_of_directory);
+        return;
+    }
+
+    const qint64 dataEnd = device->pos();
+    header.compressedSize = dataEnd - dataStart;
+    if (!zip64 && (quint64(header.uncompressedSize) >= Zip64Limit
+                   || quint64(header.compressedSize) >= Zip64Limit)) {
+        qWarning("QZip: %ls grew past 4 GiB while being added", qUtf16Printable(fileName));
+        status = QZipWriter::FileWriteError;
+        device->seek(start_of_directory);
+        return;
+    }
+    setEntrySizes(header, crc, zip64);
+
+    device->seek(header.localHeaderOffset);
+    if (!writeLocalHeader(header, zip64))
+        status = QZipWriter::FileWriteError;
+    device->seek(dataEnd);
+
+    fileHeaders.append(header);
+    start_of_directory = dataEnd;
+    dirtyFileTree = true;
+}
+
 //////////////////////////////  Reader
 
 /*!
@@ -898,82 +1380,35 @@ QZipReader::FileInfo QZipReader::entryInfoAt(int index) const
 */
 QByteArray QZipReader::fileData(const QString &fileName) const
 {
-    d->scanFiles();
-    int i;
-    for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromLocal8Bit(d->fileHeaders.at(i).file_name) == fileName)
-            break;
-    }
-    if (i == d->fileHeaders.size())
-        return QByteArray();
-
-    FileHeader header = d->fileHeaders.at(i);
-
-    ushort version_needed = readUShort(header.h.version_needed);
-    if (version_needed > ZIP_VERSION) {
-        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+    const int i = d->entryIndex(fileName);
+    if (i < 0)
         return QByteArray();
-    }
-
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-    //qDebug("uncompressing file %d: local header at %d", i, start);
-
-    d->device->seek(start);
-    LocalFileHeader lh;
-    d->device->read((char *)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    d->device->seek(d->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
-    //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
 
-    if ((general_purpose_bits & Encrypted) != 0) {
-        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
-        return QByteArray();
-    }
+    QByteArray data;
+    data.reserve(qMin(d->fileHeaders.at(i).uncompressedSize, qint64(16 * 1024 * 1024)));
+    d->readEntryData(i, [&data](const char *chunk, qint64 len) {
+        data.append(chunk, len);
+        return true;
+    });
+    return data;
+}
 
-    //qDebug("file at %lld", d->device->pos());
-    QByteArray compressed = d->device->read(compressed_size);
-    if (compression_method == CompressionMethodStored) {
-        // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
-    } else if (compression_method == CompressionMethodDeflated) {
-        // Deflate
-        //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
-        QByteArray baunzip;
-        ulong len = qMax(uncompressed_size,  1);
-        int res;
-        do {
-            baunzip.resize(len);
-            res = inflate((uchar*)baunzip.data(), &len,
-                          (const uchar*)compressed.constData(), compressed_size);
-
-            switch (res) {
-            case Z_OK:
-                if ((int)len != baunzip.size())
-                    baunzip.resize(len);
-                break;
-            case Z_MEM_ERROR:
-                qWarning("QZip: Z_MEM_ERROR: Not enough memory");
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            case Z_DATA_ERROR:
-                qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
-        return baunzip;
-    }
+/*!
+    \since 6.7
 
-    qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
-    return QByteArray();
+    Writes the uncompressed contents of the file \a fileName in the archive
+    to \a device, without holding them in memory as a whole. Returns \c true
+    if the entry was found and written entirely; otherwise returns \c false.
+*/
+bool QZipReader::fileData(const QString &fileName, QIODevice *device) const
+{
+    Q_ASSERT(device);
+    const int i = d->entryIndex(fileName);
+    if (i < 0)
+        return false;
+    return d->readEntryData(i, [device](const char *chunk, qint64 len) {
+        return device->write(chunk, len) == len;
+    });
 }
 
 /*!
@@ -1036,13 +1471,18 @@ bool QZipReader::extractAll(const QString &destinationDir) const
         }
     }
 
-    for (const FileInfo &fi : allFiles) {
+    for (int i = 0; i < allFiles.size(); ++i) {
+        const FileInfo &fi = allFiles.at(i);
         const QString absPath = destinationDir + QDir::separator() + fi.filePath;
         if (fi.isFile) {
             QFile f(absPath);
             if (!f.open(QIODevice::WriteOnly))
                 return false;
-            f.write(fileData(fi.filePath));
+            const bool written = d->readEntryData(i, [&f](const char *chunk, qint64 len) {
+                return f.write(chunk, len) == len;
+            });
+            if (!written)
+                return false;
             f.setPermissions(fi.permissions);
             f.close();
         }
@@ -1092,6 +1532,11 @@ void QZipReader::close()
     QZipWriter can be used to create a zip archive containing any number of files
     and directories. The files in the archive will be compressed in a way that is
     compatible with common zip reader applications.
+
+    Large files added from a QByteArray are compressed in parallel on a thread
+    pool owned by the writer, and are written to the archive in the order in
+    which they were added. Archives and entries larger than 4 GiB, and
+    archives with more than 65535 entries, use the zip64 extensions.
 */
 
 
@@ -1261,8 +1706,8 @@ void QZipWriter::addFile(const QString &fileName, const QByteArray &data)
 
 /*!
     Add a file to the archive with \a device as the source of the contents.
-    The contents returned from QIODevice::readAll() will be used as the
-    filedata.
+    The contents are read from the device until it has no more data and are
+    compressed as they are read, so they are never held in memory as a whole.
     The file will be stored in the archive using the \a fileName which
     includes the full path in the archive.
 */
@@ -1278,7 +1723,7 @@ void QZipWriter::addFile(const QString &fileName, QIODevice *device)
             return;
         }
     }
-    d->addEntry(QZipWriterPrivate::File, QDir::fromNativeSeparators(fileName), device->readAll());
+    d->addStreamedEntry(QDir::fromNativeSeparators(fileName), device);
     if (opened)
         device->close();
 }
@@ -1316,6 +1761,8 @@ void QZipWriter::close()
         return;
     }
 
+    d->writePendingEntries(0);
+
     //qDebug("QZip::close writing directory, %d entries", d->fileHeaders.size());
     d->device->seek(d->start_of_directory);
     // write new directory
@@ -1326,17 +1773,44 @@ void QZipWriter::close()
         d->device->write(header.extra_field);
         d->device->write(header.file_comment);
     }
-    int dir_size = d->device->pos() - d->start_of_directory;
+    const qint64 dir_size = d->device->pos() - d->start_of_directory;
+    const quint64 num_dir_entries = d->fileHeaders.size();
+
+    // values that don't fit into the EndOfDirectory are stored in a zip64
+    // EndOfDirectory record, found through a locator
+    if (num_dir_entries >= 0xffff || quint64(dir_size) >= Zip64Limit
+        || quint64(d->start_of_directory) >= Zip64Limit) {
+        const qint64 eod64_pos = d->device->pos();
+        Zip64EndOfDirectory eod64;
+        memset(&eod64, 0, sizeof(Zip64EndOfDirectory));
+        writeUInt(eod64.signature, 0x06064b50);
+        writeULongLong(eod64.record_size, sizeof(Zip64EndOfDirectory) - 12);
+        writeUShort(eod64.version_made, HostUnix << 8 | ZIP64_VERSION);
+        writeUShort(eod64.version_needed, ZIP64_VERSION);
+        writeULongLong(eod64.num_dir_entries_this_disk, num_dir_entries);
+        writeULongLong(eod64.num_dir_entries, num_dir_entries);
+        writeULongLong(eod64.directory_size, dir_size);
+        writeULongLong(eod64.dir_start_offset, d->start_of_directory);
+        d->device->write((const char *)&eod64, sizeof(Zip64EndOfDirectory));
+
+        Zip64EndOfDirectoryLocator locator;
+        memset(&locator, 0, sizeof(Zip64EndOfDirectoryLocator));
+        writeUInt(locator.signature, 0x07064b50);
+        writeULongLong(locator.eod_offset, eod64_pos);
+        writeUInt(locator.total_disks, 1);
+        d->device->write((const char *)&locator, sizeof(Zip64EndOfDirectoryLocator));
+    }
+
     // write end of directory
     EndOfDirectory eod;
     memset(&eod, 0, sizeof(EndOfDirectory));
     writeUInt(eod.signature, 0x06054b50);
     //uchar this_disk[2];
     //uchar start_of_directory_disk[2];
-    writeUShort(eod.num_dir_entries_this_disk, d->fileHeaders.size());
-    writeUShort(eod.num_dir_entries, d->fileHeaders.size());
-    writeUInt(eod.directory_size, dir_size);
-    writeUInt(eod.dir_start_offset, d->start_of_directory);
+    writeUShort(eod.num_dir_entries_this_disk, qMin(num_dir_entries, quint64(0xffff)));
+    writeUShort(eod.num_dir_entries, qMin(num_dir_entries, quint64(0xffff)));
+    writeUInt(eod.directory_size, qMin(quint64(dir_size), Zip64Limit));
+    writeUInt(eod.dir_start_offset, qMin(quint64(d->start_of_directory), Zip64Limit));
     writeUShort(eod.comment_length, d->comment.size());
 
     d->device->write((const char *)&eod, sizeof(EndOfDirectory));
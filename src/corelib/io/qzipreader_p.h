@@ -61,6 +61,7 @@ public:
 
     FileInfo entryInfoAt(int index) const;
     QByteArray fileData(const QString &fileName) const;
+    bool fileData(const QString &fileName, QIODevice *device) const;
     bool extractAll(const QString &destinationDir) const;
 
     enum Status {
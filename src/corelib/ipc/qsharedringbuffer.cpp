@@ -0,0 +1,679 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsharedringbuffer_p.h"
+
+#include <qdebug.h>
+#include <qscopeguard.h>
+#include <qthread.h>
+
+#include <private/qfutex_p.h>
+#include <private/qobject_p.h>
+#include <private/qsimd_p.h>
+
+#include <atomic>
+#include <memory>
+#include <new>
+
+QT_BEGIN_NAMESPACE
+
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(thread)
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+enum : quint32 {
+    RingMagic = 0x474e5251,             // "QRNG"
+    RingVersion = 1,
+    PaddingRecord = 0xffffffffU
+};
+
+constexpr quint32 CacheLineSize = 64;
+constexpr quint32 MinimumCapacity = 4096;
+constexpr quint32 MaximumCapacity = 1U << 30;
+constexpr int SpinCount = 256;
+
+struct RecordHeader
+{
+    quint32 size;
+    quint32 reserved;
+};
+
+/*
+    The control block at the start of the segment. Positions are free-running
+    32-bit counters (the capacity is a power of two, so they wrap cleanly);
+    the producer-owned and consumer-owned words live on separate cache lines.
+    The sequence words double as futex words for waking waiters in other
+    processes.
+*/
+struct alignas(CacheLineSize) RingHeader
+{
+    QBasicAtomicInteger<quint32> magic;
+    quint32 version;
+    quint32 capacity;
+    quint32 producerMode;
+    QBasicAtomicInteger<quint32> writerLock;
+
+    alignas(CacheLineSize) QBasicAtomicInteger<quint32> head;
+    QBasicAtomicInteger<quint32> dataSequence;
+    QBasicAtomicInteger<quint32> consumersWaiting;
+
+    alignas(CacheLineSize) QBasicAtomicInteger<quint32> tail;
+    QBasicAtomicInteger<quint32> spaceSequence;
+    QBasicAtomicInteger<quint32> producersWaiting;
+};
+static_assert(sizeof(RingHeader) % CacheLineSize == 0);
+static_assert(std::is_trivially_destructible_v<RingHeader>);
+
+constexpr quint32 recordSize(qsizetype payload)
+{
+    return (quint32(sizeof(RecordHeader) + payload) + 7) & ~7U;
+}
+
+#if defined(Q_OS_LINUX) && defined(QT_ALWAYS_USE_FUTEX)
+// QtFutex uses process-private futexes; these words are shared with other
+// processes, so we need the plain variants.
+void sharedWait(QBasicAtomicInteger<quint32> &word, quint32 expected, QDeadlineTimer deadline)
+{
+    struct timespec ts;
+    struct timespec *timeout = nullptr;
+    if (!deadline.isForever()) {
+        const qint64 ns = deadline.remainingTimeNSecs();
+        if (ns <= 0)
+            return;
+        ts.tv_sec = ns / (1000 * 1000 * 1000);
+        ts.tv_nsec = ns % (1000 * 1000 * 1000);
+        timeout = &ts;
+    }
+    syscall(__NR_futex, QtLinuxFutex::addr(&word), FUTEX_WAIT, int(expected), timeout,
+            nullptr, 0);
+}
+
+void sharedWakeAll(QBasicAtomicInteger<quint32> &word)
+{
+    syscall(__NR_futex, QtLinuxFutex::addr(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+#else
+// Address-based waits elsewhere (WaitOnAddress, __ulock_wait) only work
+// within one process, so fall back to polling.
+void sharedWait(QBasicAtomicInteger<quint32> &word, quint32 expected, QDeadlineTimer deadline)
+{
+    if (word.loadAcquire() != expected)
+        return;
+    qint64 us = 100;
+    if (!deadline.isForever())
+        us = qBound(0, deadline.remainingTimeNSecs() / 1000, us);
+    if (us)
+        QThread::usleep(us);
+}
+
+void sharedWakeAll(QBasicAtomicInteger<quint32> &)
+{
+}
+#endif
+
+} // unnamed namespace
+
+class QSharedRingBufferPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QSharedRingBuffer)
+public:
+    QSharedRingBufferPrivate(const QNativeIpcKey &key) : memory(key) {}
+
+    bool setup(bool created);
+    void reset();
+
+    bool push(QByteArrayView message, quint32 *observedTail);
+    bool waitForChange(QBasicAtomicInteger<quint32> &position, quint32 known,
+                       QBasicAtomicInteger<quint32> &sequence,
+                       QBasicAtomicInteger<quint32> &waiters,
+                       QDeadlineTimer deadline, const QAtomicInt *cancel = nullptr);
+    void signal(QBasicAtomicInteger<quint32> &sequence, QBasicAtomicInteger<quint32> &waiters);
+    void lockWriters();
+    void unlockWriters();
+
+    void startNotifier();
+    void stopNotifier();
+    void runNotifier();
+
+    QSharedMemory memory;
+    RingHeader *header = nullptr;
+    uchar *data = nullptr;
+    quint32 capacity = 0;
+    QSharedRingBuffer::ProducerMode mode = QSharedRingBuffer::SingleProducer;
+    QString errorString;
+
+    std::unique_ptr<QThread> notifier;
+    QAtomicInt stopRequested;
+    QAtomicInt notificationPending;
+    bool notificationsEnabled = false;
+};
+
+namespace {
+class QSharedRingBufferNotifier : public QThread
+{
+public:
+    explicit QSharedRingBufferNotifier(QSharedRingBufferPrivate *d) : d(d) {}
+
+protected:
+    void run() override { d->runNotifier(); }
+
+private:
+    QSharedRingBufferPrivate *d;
+};
+} // unnamed namespace
+
+bool QSharedRingBufferPrivate::setup(bool created)
+{
+    auto *segment = static_cast<uchar *>(memory.data());
+    header = reinterpret_cast<RingHeader *>(segment);
+    if (created) {
+        header = new (segment) RingHeader{};
+        header->version = RingVersion;
+        header->capacity = capacity;
+        header->producerMode = mode;
+        header->magic.storeRelease(RingMagic);
+    } else {
+        if (size_t(memory.size()) < sizeof(RingHeader)
+                || header->magic.loadAcquire() != RingMagic
+                || header->version != RingVersion) {
+            errorString = QSharedRingBuffer::tr("Shared memory segment is not a ring buffer");
+            return false;
+        }
+        capacity = header->capacity;
+        if (capacity < MinimumCapacity || capacity > MaximumCapacity
+                || (capacity & (capacity - 1)) != 0
+                || size_t(memory.size()) < sizeof(RingHeader) + capacity) {
+            errorString = QSharedRingBuffer::tr("Ring buffer header is corrupted");
+            return false;
+        }
+        mode = QSharedRingBuffer::ProducerMode(header->producerMode);
+    }
+    data = segment + sizeof(RingHeader);
+    errorString.clear();
+    if (notificationsEnabled)
+        startNotifier();
+    return true;
+}
+
+void QSharedRingBufferPrivate::reset()
+{
+    stopNotifier();
+    header = nullptr;
+    data = nullptr;
+    capacity = 0;
+}
+
+void QSharedRingBufferPrivate::signal(QBasicAtomicInteger<quint32> &sequence,
+                                      QBasicAtomicInteger<quint32> &waiters)
+{
+    // pairs with the fence in waitForChange(): either the waiter sees our
+    // position update, or we see the waiter and bump the futex word
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.loadRelaxed()) {
+        sequence.fetchAndAddRelease(1);
+        sharedWakeAll(sequence);
+    }
+}
+
+bool QSharedRingBufferPrivate::waitForChange(QBasicAtomicInteger<quint32> &position, quint32 known,
+                                             QBasicAtomicInteger<quint32> &sequence,
+                                             QBasicAtomicInteger<quint32> &waiters,
+                                             QDeadlineTimer deadline, const QAtomicInt *cancel)
+{
+    // the other side is usually only a few hundred nanoseconds away
+    for (int i = 0; i < SpinCount; ++i) {
+        if (position.loadAcquire() != known)
+            return true;
+        qYieldCpu();
+    }
+
+    waiters.fetchAndAddOrdered(1);
+    auto cleanup = qScopeGuard([&] { waiters.fetchAndSubRelaxed(1); });
+    forever {
+        const quint32 seq = sequence.loadAcquire();
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (position.loadAcquire() != known)
+            return true;
+        if ((cancel && cancel->loadRelaxed()) || deadline.hasExpired())
+            return false;
+        sharedWait(sequence, seq, deadline);
+    }
+}
+
+void QSharedRingBufferPrivate::lockWriters()
+{
+    if (mode != QSharedRingBuffer::MultiProducer)
+        return;
+
+    // 0: unlocked, 1: locked, 2: locked with possible waiters
+    QBasicAtomicInteger<quint32> &lock = header->writerLock;
+    if (lock.testAndSetAcquire(0, 1))
+        return;
+    for (int i = 0; i < SpinCount; ++i) {
+        qYieldCpu();
+        if (lock.loadRelaxed() == 0 && lock.testAndSetAcquire(0, 1))
+            return;
+    }
+    while (lock.fetchAndStoreAcquire(2) != 0)
+        sharedWait(lock, 2, QDeadlineTimer::Forever);
+}
+
+void QSharedRingBufferPrivate::unlockWriters()
+{
+    if (mode != QSharedRingBuffer::MultiProducer)
+        return;
+    if (header->writerLock.fetchAndStoreRelease(0) == 2)
+        sharedWakeAll(header->writerLock);
+}
+
+bool QSharedRingBufferPrivate::push(QByteArrayView message, quint32 *observedTail)
+{
+    const quint32 record = recordSize(message.size());
+    const quint32 head = header->head.loadRelaxed();
+    const quint32 tail = header->tail.loadAcquire();
+    const quint32 offset = head & (capacity - 1);
+    const quint32 contiguous = capacity - offset;
+    const quint32 padding = contiguous < record ? contiguous : 0;
+    if (capacity - (head - tail) < padding + record) {
+        *observedTail = tail;
+        return false;
+    }
+
+    uchar *p = data + offset;
+    if (padding) {
+        // records never wrap; skip to the start of the buffer instead
+        const RecordHeader pad = { PaddingRecord, 0 };
+        memcpy(p, &pad, sizeof(pad));
+        p = data;
+    }
+    const RecordHeader hdr = { quint32(message.size()), 0 };
+    memcpy(p, &hdr, sizeof(hdr));
+    if (!message.isEmpty())
+        memcpy(p + sizeof(hdr), message.data(), message.size());
+
+    header->head.storeRelease(head + padding + record);
+    signal(header->dataSequence, header->consumersWaiting);
+    return true;
+}
+
+void QSharedRingBufferPrivate::startNotifier()
+{
+    if (notifier)
+        return;
+    stopRequested.storeRelaxed(0);
+    notificationPending.storeRelaxed(0);
+    notifier = std::make_unique<QSharedRingBufferNotifier>(this);
+    notifier->setObjectName("QSharedRingBuffer notifier"_L1);
+    notifier->start();
+}
+
+void QSharedRingBufferPrivate::stopNotifier()
+{
+    if (!notifier)
+        return;
+    stopRequested.storeRelease(1);
+    header->dataSequence.fetchAndAddRelease(1);
+    sharedWakeAll(header->dataSequence);
+    notifier->wait();
+    notifier.reset();
+}
+
+void QSharedRingBufferPrivate::runNotifier()
+{
+    Q_Q(QSharedRingBuffer);
+    // anything already queued counts as new data
+    quint32 known = header->tail.loadAcquire();
+    while (!stopRequested.loadAcquire()) {
+        const quint32 head = header->head.loadAcquire();
+        if (head != known) {
+            known = head;
+            if (!notificationPending.fetchAndStoreAcquire(1)) {
+                QMetaObject::invokeMethod(q, [this] {
+                    notificationPending.storeRelease(0);
+                    emit q_func()->readyRead();
+                }, Qt::QueuedConnection);
+            }
+        }
+        waitForChange(header->head, known, header->dataSequence, header->consumersWaiting,
+                      QDeadlineTimer::Forever, &stopRequested);
+    }
+}
+
+/*!
+    \class QSharedRingBuffer
+    \inmodule QtCore
+    \internal
+    \since 6.7
+
+    \brief The QSharedRingBuffer class is a message queue in a shared memory
+    segment.
+
+    QSharedRingBuffer passes length-delimited messages from producers to a
+    single consumer, which may live in different processes on the same host.
+    One side create()s the buffer, the other sides attach() to it using the
+    same QNativeIpcKey.
+
+    Messages are copied into a ring inside the segment and published with a
+    single atomic store, so no lock or system call is involved while neither
+    side needs to sleep. With ProducerMode SingleProducer, exactly one object
+    may write; MultiProducer serializes writers with a lock stored in the
+    segment. In both modes there must be only one reader.
+
+    A consumer can block in waitForReadyRead(), or enable notifications and
+    react to the readyRead() signal from its event loop. On Linux, sleeping
+    sides are woken through futexes on the shared words; on other platforms,
+    a waiting side polls the buffer at short intervals.
+
+    \sa QSharedMemory
+*/
+
+/*!
+    \enum QSharedRingBuffer::ProducerMode
+
+    \value SingleProducer   Only one QSharedRingBuffer writes to the buffer.
+    \value MultiProducer    Several QSharedRingBuffer objects, possibly in
+                            different processes, write to the buffer.
+*/
+
+/*!
+    \fn void QSharedRingBuffer::readyRead()
+
+    This signal is emitted in the object's thread after new messages were
+    published, if notifications are enabled. It is not emitted again until
+    control returns to the event loop.
+
+    \sa setNotificationsEnabled(), tryRead()
+*/
+
+/*!
+    Constructs a ring buffer object for the shared memory segment identified
+    by \a key, with the given \a parent. Call create() or attach() before
+    using it.
+*/
+QSharedRingBuffer::QSharedRingBuffer(const QNativeIpcKey &key, QObject *parent)
+    : QObject(*new QSharedRingBufferPrivate(key), parent)
+{
+}
+
+/*!
+    Destroys the object, detaching from the segment.
+*/
+QSharedRingBuffer::~QSharedRingBuffer()
+{
+    Q_D(QSharedRingBuffer);
+    d->reset();
+}
+
+/*!
+    Returns the key identifying the shared memory segment.
+*/
+QNativeIpcKey QSharedRingBuffer::nativeIpcKey() const
+{
+    Q_D(const QSharedRingBuffer);
+    return d->memory.nativeIpcKey();
+}
+
+/*!
+    Creates the shared memory segment with room for at least \a capacity
+    bytes of messages and attaches to it. The capacity is rounded up to a
+    power of two of at least 4 KiB; the largest supported capacity is 1 GiB.
+    \a mode selects whether several producers may write concurrently.
+
+    Returns \c true on success.
+
+    \sa attach(), capacity()
+*/
+bool QSharedRingBuffer::create(qsizetype capacity, ProducerMode mode)
+{
+    Q_D(QSharedRingBuffer);
+    if (isAttached()) {
+        d->errorString = tr("Already attached to a ring buffer");
+        return false;
+    }
+    if (capacity < 0 || capacity > qsizetype(MaximumCapacity)) {
+        d->errorString = tr("Invalid ring buffer capacity %1").arg(capacity);
+        return false;
+    }
+    const quint32 rounded = qNextPowerOfTwo(qMax(quint32(capacity), MinimumCapacity) - 1);
+    if (!d->memory.create(sizeof(RingHeader) + rounded)) {
+        d->errorString = d->memory.errorString();
+        return false;
+    }
+    d->capacity = rounded;
+    d->mode = mode;
+    return d->setup(true);
+}
+
+/*!
+    Attaches to a ring buffer that another object created. Returns \c true
+    on success.
+
+    \sa create(), detach()
+*/
+bool QSharedRingBuffer::attach()
+{
+    Q_D(QSharedRingBuffer);
+    if (isAttached()) {
+        d->errorString = tr("Already attached to a ring buffer");
+        return false;
+    }
+    if (!d->memory.attach()) {
+        d->errorString = d->memory.errorString();
+        return false;
+    }
+    if (!d->setup(false)) {
+        d->memory.detach();
+        d->header = nullptr;
+        return false;
+    }
+    return true;
+}
+
+/*!
+    Returns \c true if the object is attached to a ring buffer.
+*/
+bool QSharedRingBuffer::isAttached() const
+{
+    Q_D(const QSharedRingBuffer);
+    return d->header != nullptr;
+}
+
+/*!
+    Detaches from the shared memory segment. Messages still in the buffer
+    remain available to other attached objects; the segment is destroyed
+    when the last object detaches.
+*/
+bool QSharedRingBuffer::detach()
+{
+    Q_D(QSharedRingBuffer);
+    if (!isAttached())
+        return false;
+    d->reset();
+    return d->memory.detach();
+}
+
+/*!
+    Returns the number of bytes available for messages and their framing.
+*/
+qsizetype QSharedRingBuffer::capacity() const
+{
+    Q_D(const QSharedRingBuffer);
+    return d->capacity;
+}
+
+/*!
+    Returns the size of the largest message that can be written, which is
+    slightly less than half the capacity.
+*/
+qsizetype QSharedRingBuffer::maxMessageSize() const
+{
+    Q_D(const QSharedRingBuffer);
+    return d->capacity ? d->capacity / 2 - qsizetype(sizeof(RecordHeader)) : 0;
+}
+
+/*!
+    Returns the producer mode the buffer was created with.
+*/
+QSharedRingBuffer::ProducerMode QSharedRingBuffer::producerMode() const
+{
+    Q_D(const QSharedRingBuffer);
+    return d->mode;
+}
+
+/*!
+    Appends \a message to the buffer if there is room for it and returns
+    \c true. Returns \c false without blocking if the buffer is full, or if
+    the message is larger than maxMessageSize().
+
+    \sa write()
+*/
+bool QSharedRingBuffer::tryWrite(QByteArrayView message)
+{
+    Q_D(QSharedRingBuffer);
+    if (!d->header || message.size() > maxMessageSize())
+        return false;
+
+    d->lockWriters();
+    quint32 tail;
+    const bool written = d->push(message, &tail);
+    d->unlockWriters();
+    return written;
+}
+
+/*!
+    Appends \a message to the buffer, waiting until \a deadline for the
+    consumer to make room if necessary. Returns \c true if the message was
+    written.
+
+    \sa tryWrite()
+*/
+bool QSharedRingBuffer::write(QByteArrayView message, QDeadlineTimer deadline)
+{
+    Q_D(QSharedRingBuffer);
+    if (!d->header)
+        return false;
+    if (message.size() > maxMessageSize()) {
+        qWarning("QSharedRingBuffer::write: message of %lld bytes exceeds the maximum of %lld",
+                 qlonglong(message.size()), qlonglong(maxMessageSize()));
+        return false;
+    }
+
+    forever {
+        d->lockWriters();
+        quint32 tail;
+        const bool written = d->push(message, &tail);
+        d->unlockWriters();
+        if (written)
+            return true;
+        if (!d->waitForChange(d->header->tail, tail, d->header->spaceSequence,
+                              d->header->producersWaiting, deadline)) {
+            return false;
+        }
+    }
+}
+
+/*!
+    Returns \c true if a message is waiting to be read.
+*/
+bool QSharedRingBuffer::hasMessage() const
+{
+    Q_D(const QSharedRingBuffer);
+    return d->header && d->header->head.loadAcquire() != d->header->tail.loadRelaxed();
+}
+
+/*!
+    Removes the oldest message from the buffer and stores it in \a message,
+    if there is one. Returns \c false if the buffer is empty.
+
+    Only one object may read from a buffer at any time.
+
+    \sa waitForReadyRead(), readyRead()
+*/
+bool QSharedRingBuffer::tryRead(QByteArray *message)
+{
+    Q_D(QSharedRingBuffer);
+    if (!d->header)
+        return false;
+
+    quint32 tail = d->header->tail.loadRelaxed();
+    if (d->header->head.loadAcquire() == tail)
+        return false;
+
+    const quint32 mask = d->capacity - 1;
+    RecordHeader hdr;
+    memcpy(&hdr, d->data + (tail & mask), sizeof(hdr));
+    if (hdr.size == PaddingRecord) {
+        tail += d->capacity - (tail & mask);
+        memcpy(&hdr, d->data, sizeof(hdr));
+    }
+    if (hdr.size > quint32(maxMessageSize())) {
+        d->errorString = tr("Ring buffer is corrupted");
+        qWarning("QSharedRingBuffer::tryRead: invalid message size %u", hdr.size);
+        return false;
+    }
+
+    if (message) {
+        const uchar *payload = d->data + (tail & mask) + sizeof(hdr);
+        message->assign(QByteArrayView(payload, hdr.size));
+    }
+    d->header->tail.storeRelease(tail + recordSize(hdr.size));
+    d->signal(d->header->spaceSequence, d->header->producersWaiting);
+    return true;
+}
+
+/*!
+    Waits until a message is available or \a deadline expires. Returns
+    \c true if a message can be read.
+*/
+bool QSharedRingBuffer::waitForReadyRead(QDeadlineTimer deadline)
+{
+    Q_D(QSharedRingBuffer);
+    if (!d->header)
+        return false;
+    const quint32 tail = d->header->tail.loadRelaxed();
+    return d->waitForChange(d->header->head, tail, d->header->dataSequence,
+                            d->header->consumersWaiting, deadline);
+}
+
+/*!
+    Enables readyRead() emission if \a enable is \c true, or disables it
+    otherwise. Notifications are delivered by a helper thread that sleeps
+    while the buffer is idle. They are off by default.
+*/
+void QSharedRingBuffer::setNotificationsEnabled(bool enable)
+{
+    Q_D(QSharedRingBuffer);
+    d->notificationsEnabled = enable;
+    if (!d->header)
+        return;
+    if (enable)
+        d->startNotifier();
+    else
+        d->stopNotifier();
+}
+
+/*!
+    Returns \c true if readyRead() notifications are enabled.
+*/
+bool QSharedRingBuffer::notificationsEnabled() const
+{
+    Q_D(const QSharedRingBuffer);
+    return d->notificationsEnabled;
+}
+
+/*!
+    Returns a description of the last error that occurred.
+*/
+QString QSharedRingBuffer::errorString() const
+{
+    Q_D(const QSharedRingBuffer);
+    return d->errorString;
+}
+
+#endif // QT_CONFIG(sharedmemory) && QT_CONFIG(thread)
+
+QT_END_NAMESPACE
+
+#include "moc_qsharedringbuffer_p.cpp"
@@ -0,0 +1,80 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSHAREDRINGBUFFER_P_H
+#define QSHAREDRINGBUFFER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qsharedmemory.h>
+
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(thread)
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qdeadlinetimer.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSharedRingBufferPrivate;
+
+class Q_CORE_EXPORT QSharedRingBuffer : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QSharedRingBuffer)
+
+public:
+    enum ProducerMode {
+        SingleProducer,
+        MultiProducer
+    };
+
+    explicit QSharedRingBuffer(const QNativeIpcKey &key, QObject *parent = nullptr);
+    ~QSharedRingBuffer();
+
+    QNativeIpcKey nativeIpcKey() const;
+
+    bool create(qsizetype capacity, ProducerMode mode = SingleProducer);
+    bool attach();
+    bool isAttached() const;
+    bool detach();
+
+    qsizetype capacity() const;
+    qsizetype maxMessageSize() const;
+    ProducerMode producerMode() const;
+
+    // producer side
+    bool tryWrite(QByteArrayView message);
+    bool write(QByteArrayView message, QDeadlineTimer deadline = QDeadlineTimer::Forever);
+
+    // consumer side
+    bool hasMessage() const;
+    bool tryRead(QByteArray *message);
+    bool waitForReadyRead(QDeadlineTimer deadline = QDeadlineTimer::Forever);
+    void setNotificationsEnabled(bool enable);
+    bool notificationsEnabled() const;
+
+    QString errorString() const;
+
+Q_SIGNALS:
+    void readyRead();
+
+private:
+    Q_DISABLE_COPY(QSharedRingBuffer)
+};
+
+QT_END_NAMESPACE
+
+#endif // QT_CONFIG(sharedmemory) && QT_CONFIG(thread)
+
+#endif // QSHAREDRINGBUFFER_P_H
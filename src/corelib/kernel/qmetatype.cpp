@@ -57,6 +57,7 @@
 #endif
 
 #include <bitset>
+#include <memory>
 #include <new>
 #include <cstring>
 
@@ -98,11 +99,47 @@ struct QMetaTypeCustomRegistry
     }
 #endif
 
+    ~QMetaTypeCustomRegistry()
+    {
+        for (auto &block : blocks)
+            delete[] block.loadRelaxed();
+    }
+
+    // The registry is append-only storage of interface pointers: blocks are
+    // allocated on demand and never move, so getCustomType() can read it
+    // without taking the lock. Slots are only written with the lock held.
+    using Slot = QAtomicPointer<const QtPrivate::QMetaTypeInterface>;
+    static constexpr int BlockShift = 10;
+    static constexpr int BlockSize = 1 << BlockShift;
+    static constexpr int MaxBlocks = 2048;
+    QAtomicPointer<Slot> blocks[MaxBlocks] = {};
+
     QReadWriteLock lock;
-    QList<const QtPrivate::QMetaTypeInterface *> registry;
     QHash<QByteArray, const QtPrivate::QMetaTypeInterface *> aliases;
+    // number of slots in use, including unregistered ones
+    int size = 0;
     // index of first empty (unregistered) type in registry, if any.
     int firstEmpty = 0;
+    // incremented whenever a name stops referring to a type; see
+    // cachedTypeForName()
+    QAtomicInteger<quint32> generation;
+
+    Slot &slot(int idx)
+    {
+        Q_ASSERT(idx >= 0 && idx < size);
+        return blocks[idx >> BlockShift].loadRelaxed()[idx & (BlockSize - 1)];
+    }
+
+    bool appendSlot()
+    {
+        if (size == BlockSize * MaxBlocks)
+            return false;
+        QAtomicPointer<Slot> &block = blocks[size >> BlockShift];
+        if (!block.loadRelaxed())
+            block.storeRelease(new Slot[BlockSize]{});
+        ++size;
+        return true;
+    }
 
     int registerCustomType(const QtPrivate::QMetaTypeInterface *cti)
     {
@@ -123,17 +160,16 @@ struct QMetaTypeCustomRegistry
                 ti->typeId.storeRelaxed(id);
                 return id;
             }
-            aliases[name] = ti;
-            int size = registry.size();
-            while (firstEmpty < size && registry[firstEmpty])
-                ++firstEmpty;
-            if (firstEmpty < size) {
-                registry[firstEmpty] = ti;
+            while (firstEmpty < size && slot(firstEmpty).loadRelaxed())
                 ++firstEmpty;
-            } else {
-                registry.append(ti);
-                firstEmpty = registry.size();
+            if (firstEmpty == size && !appendSlot()) {
+                qWarning("QMetaType: cannot register more than %d custom types",
+                         BlockSize * MaxBlocks);
+                return 0;
             }
+            aliases[name] = ti;
+            slot(firstEmpty).storeRelease(ti);
+            ++firstEmpty;
             ti->typeId.storeRelaxed(firstEmpty + QMetaType::User);
         }
         if (ti->legacyRegisterOp)
@@ -148,7 +184,7 @@ struct QMetaTypeCustomRegistry
         Q_ASSERT(id > QMetaType::User);
         QWriteLocker l(&lock);
         int idx = id - QMetaType::User - 1;
-        auto &ti = registry[idx];
+        const auto ti = slot(idx).loadRelaxed();
 
         // We must unregister all names.
         auto it = aliases.begin();
@@ -159,15 +195,19 @@ struct QMetaTypeCustomRegistry
                 ++it;
         }
 
-        ti = nullptr;
+        slot(idx).storeRelease(nullptr);
+        generation.fetchAndAddRelease(1);
 
         firstEmpty = std::min(firstEmpty, idx);
     }
 
     const QtPrivate::QMetaTypeInterface *getCustomType(int id)
     {
-        QReadLocker l(&lock);
-        return registry.value(id - QMetaType::User - 1);
+        const int idx = id - QMetaType::User - 1;
+        if (idx < 0 || idx >= BlockSize * MaxBlocks)
+            return nullptr;
+        const Slot *block = blocks[idx >> BlockShift].loadAcquire();
+        return block ? block[idx & (BlockSize - 1)].loadAcquire() : nullptr;
     }
 };
 
@@ -2676,17 +2716,58 @@ bool QMetaType::hasRegisteredMutableViewFunction(QMetaType fromType, QMetaType t
     \sa typeName()
 */
 
+namespace {
+// Open-addressing index over types[], built on first use, so that looking up
+// a builtin type by name does not scan the whole table.
+struct QMetaTypeStaticNameIndex
+{
+    static constexpr size_t TableSize = 512;
+    quint16 slots[TableSize] = {};      // index into types[] + 1; 0 if empty
+
+    QMetaTypeStaticNameIndex()
+    {
+        for (int i = 0; types[i].typeName; ++i) {
+            const QByteArrayView name(types[i].typeName, types[i].typeNameLength);
+            size_t pos = qHash(name) & (TableSize - 1);
+            for ( ; slots[pos]; pos = (pos + 1) & (TableSize - 1)) {
+                if (name == typeName(slots[pos] - 1))
+                    break;      // first entry for a name wins, as in a linear scan
+            }
+            if (!slots[pos])
+                slots[pos] = quint16(i + 1);
+        }
+    }
+
+    static QByteArrayView typeName(int i)
+    {
+        return QByteArrayView(types[i].typeName, types[i].typeNameLength);
+    }
+
+    int find(QByteArrayView name, size_t hash) const
+    {
+        for (size_t pos = hash & (TableSize - 1); slots[pos]; pos = (pos + 1) & (TableSize - 1)) {
+            if (name == typeName(slots[pos] - 1))
+                return types[slots[pos] - 1].type;
+        }
+        return QMetaType::UnknownType;
+    }
+};
+static_assert(std::size(types) * 2 <= QMetaTypeStaticNameIndex::TableSize);
+} // unnamed namespace
+
 /*
     Similar to QMetaType::type(), but only looks in the static set of types.
 */
+static inline int qMetaTypeStaticType(QByteArrayView typeName, size_t hash)
+{
+    static const QMetaTypeStaticNameIndex index;
+    return index.find(typeName, hash);
+}
+
 static inline int qMetaTypeStaticType(const char *typeName, int length)
 {
-    int i = 0;
-    while (types[i].typeName && ((length != types[i].typeNameLength)
-                                 || memcmp(typeName, types[i].typeName, length))) {
-        ++i;
-    }
-    return types[i].type;
+    const QByteArrayView name(typeName, length);
+    return qMetaTypeStaticType(name, qHash(name));
 }
 
 /*
@@ -2754,14 +2835,74 @@ bool QMetaType::isRegistered(int type)
     return interfaceForTypeNoWarning(type) != nullptr;
 }
 
+namespace {
+/*
+    A small per-thread cache of names that were not found in the static
+    table, so that repeated lookups of custom types (and of names that need
+    normalizing) take neither the registry lock nor a trip through
+    QMetaObject::normalizedType(). Entries are only ever added for names
+    that resolved to a type; the registry's generation counter invalidates
+    the whole cache when a type is unregistered.
+*/
+struct QMetaTypeNameCache
+{
+    static constexpr int Size = 64;
+    struct Entry {
+        size_t hash = 0;
+        QByteArray name;
+        int type = QMetaType::UnknownType;
+        bool normalized = false;    // found only after normalizing the name
+    };
+    quint32 generation = 0;
+    Entry entries[Size];
+
+    Entry &entry(size_t hash) { return entries[(hash ^ (hash >> 16)) & (Size - 1)]; }
+
+    void sync(quint32 current)
+    {
+        if (generation == current)
+            return;
+        for (Entry &e : entries)
+            e = Entry();
+        generation = current;
+    }
+};
+
+QMetaTypeNameCache *threadNameCache()
+{
+    // allocated lazily: most threads never look types up by name
+    Q_CONSTINIT static thread_local std::unique_ptr<QMetaTypeNameCache> cache;
+    if (!cache)
+        cache = std::make_unique<QMetaTypeNameCache>();
+    return cache.get();
+}
+} // unnamed namespace
+
 template <bool tryNormalizedType>
 static inline int qMetaTypeTypeImpl(const char *typeName, int length)
 {
     if (!length)
         return QMetaType::UnknownType;
-    int type = qMetaTypeStaticType(typeName, length);
-    if (type == QMetaType::UnknownType) {
-        QReadLocker locker(&customTypeRegistry()->lock);
+    const QByteArrayView name(typeName, length);
+    const size_t hash = qHash(name);
+    int type = qMetaTypeStaticType(name, hash);
+    if (type != QMetaType::UnknownType)
+        return type;
+
+    QMetaTypeCustomRegistry *reg = customTypeRegistry();
+    if (!reg)
+        return type;
+    QMetaTypeNameCache *cache = threadNameCache();
+    cache->sync(reg->generation.loadAcquire());
+    QMetaTypeNameCache::Entry &cached = cache->entry(hash);
+    if (cached.hash == hash && cached.name == name
+            && (tryNormalizedType || !cached.normalized)) {
+        return cached.type;
+    }
+
+    bool normalized = false;
+    {
+        QReadLocker locker(&reg->lock);
         type = qMetaTypeCustomType_unlocked(typeName, length);
 #ifndef QT_NO_QOBJECT
         if ((type == QMetaType::UnknownType) && tryNormalizedType) {
@@ -2772,9 +2913,12 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
                 type = qMetaTypeCustomType_unlocked(normalizedTypeName.constData(),
                                                     normalizedTypeName.size());
             }
+            normalized = true;
         }
 #endif
     }
+    if (type != QMetaType::UnknownType)
+        cached = { hash, name.toByteArray(), type, normalized };
     return type;
 }
 
@@ -20,6 +20,10 @@
 #include <QtCore/QBuffer>
 #include <QtCore/QUrl>
 #include <QtCore/QDebug>
+#if QT_CONFIG(thread)
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
+#endif
 
 #include <algorithm>
 #include <functional>
@@ -450,9 +454,7 @@ QMimeType QMimeDatabasePrivate::mimeTypeForData(QIODevice *device)
     return mimeTypeForName(defaultMimeType());
 }
 
-QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName,
-                                                const QFileInfo &fileInfo,
-                                                QMimeDatabase::MatchMode mode)
+static QString inodeMimeTypeName(const QString &fileName, const QFileInfo &fileInfo)
 {
     if (false) {
 #ifdef Q_OS_UNIX
@@ -463,33 +465,83 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName,
         QT_STATBUF statBuffer;
         if (QT_STAT(nativeFilePath.constData(), &statBuffer) == 0) {
             if (S_ISDIR(statBuffer.st_mode))
-                return mimeTypeForName(directoryMimeType());
+                return directoryMimeType();
             if (S_ISCHR(statBuffer.st_mode))
-                return mimeTypeForName(QStringLiteral("inode/chardevice"));
+                return QStringLiteral("inode/chardevice");
             if (S_ISBLK(statBuffer.st_mode))
-                return mimeTypeForName(QStringLiteral("inode/blockdevice"));
+                return QStringLiteral("inode/blockdevice");
             if (S_ISFIFO(statBuffer.st_mode))
-                return mimeTypeForName(QStringLiteral("inode/fifo"));
+                return QStringLiteral("inode/fifo");
             if (S_ISSOCK(statBuffer.st_mode))
-                return mimeTypeForName(QStringLiteral("inode/socket"));
+                return QStringLiteral("inode/socket");
         }
 #endif
     } else if (fileInfo.isDir()) {
-        return mimeTypeForName(directoryMimeType());
+        return directoryMimeType();
     }
+    return QString();
+}
+
+static bool readFileHeader(const QString &fileName, QByteArray *header)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    // Read 16K in one go (QIODEVICE_BUFFERSIZE in qiodevice_p.h), like
+    // the device-based matching does.
+    *header = file.read(16384);
+    return true;
+}
+
+QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName,
+                                                const QFileInfo &fileInfo,
+                                                QMimeDatabase::MatchMode mode)
+{
+    // The file system is accessed without holding the mutex, so that
+    // classifying a file does not keep other threads from using the
+    // database while the disk is busy.
+    const QString inodeType = inodeMimeTypeName(fileName, fileInfo);
+
+    QMutexLocker locker(&mutex);
+    if (!inodeType.isEmpty())
+        return mimeTypeForName(inodeType);
 
     switch (mode) {
-    case QMimeDatabase::MatchDefault:
+    case QMimeDatabase::MatchDefault: {
+        // Same as the first pass of mimeTypeForFileNameAndData(): if the
+        // name is conclusive, there is no need to read the file.
+        const QMimeGlobMatchResult candidatesByName = findByFileName(fileName);
+        if (candidatesByName.m_allMatchingMimeTypes.size() == 1) {
+            const QMimeType mime = mimeTypeForName(candidatesByName.m_matchingMimeTypes.at(0));
+            if (mime.isValid())
+                return mime;
+        }
         break;
+    }
     case QMimeDatabase::MatchExtension:
         return mimeTypeForFileExtension(fileName);
-    case QMimeDatabase::MatchContent: {
-        QFile file(fileName);
-        return mimeTypeForData(&file);
+    case QMimeDatabase::MatchContent:
+        break;
     }
+
+    locker.unlock();
+    QByteArray header;
+    const bool readable = readFileHeader(fileName, &header);
+    locker.relock();
+
+    if (mode == QMimeDatabase::MatchContent) {
+        if (!readable)
+            return mimeTypeForName(defaultMimeType());
+        int accuracy = 0;
+        return findByData(header, &accuracy);
     }
+
     // MatchDefault:
-    return mimeTypeForFileNameAndData(fileName, nullptr);
+    if (!readable)
+        return mimeTypeForFileNameAndData(fileName, nullptr);
+    QBuffer buffer(&header);
+    buffer.open(QIODevice::ReadOnly);
+    return mimeTypeForFileNameAndData(fileName, &buffer);
 }
 
 QList<QMimeType> QMimeDatabasePrivate::allMimeTypes()
@@ -625,8 +677,6 @@ QMimeType QMimeDatabase::mimeTypeForName(const QString &nameOrAlias) const
 */
 QMimeType QMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, MatchMode mode) const
 {
-    QMutexLocker locker(&d->mutex);
-
     return d->mimeTypeForFile(fileInfo.filePath(), fileInfo, mode);
 }
 
@@ -637,9 +687,8 @@ QMimeType QMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, MatchMode mo
 */
 QMimeType QMimeDatabase::mimeTypeForFile(const QString &fileName, MatchMode mode) const
 {
-    QMutexLocker locker(&d->mutex);
-
     if (mode == MatchExtension) {
+        QMutexLocker locker(&d->mutex);
         return d->mimeTypeForFileExtension(fileName);
     } else {
         QFileInfo fileInfo(fileName);
@@ -647,6 +696,63 @@ QMimeType QMimeDatabase::mimeTypeForFile(const QString &fileName, MatchMode mode
     }
 }
 
+/*!
+    \since 6.7
+
+    Returns the MIME types for the files named \a fileNames using \a mode,
+    in the same order. The result is the same as calling mimeTypeForFile()
+    for each file.
+
+    When the file contents need to be inspected, the files are read in
+    parallel on the global thread pool, which is much faster than
+    classifying them one by one when there are many files, or when they are
+    on slow storage. The calling thread takes part in the work.
+
+    \sa mimeTypeForFile(), QThreadPool::globalInstance()
+*/
+QList<QMimeType> QMimeDatabase::mimeTypesForFiles(const QStringList &fileNames,
+                                                  MatchMode mode) const
+{
+    QList<QMimeType> result(fileNames.size());
+    QMimeType *out = result.data();
+    if (mode == MatchExtension) {
+        QMutexLocker locker(&d->mutex);
+        for (qsizetype i = 0; i < fileNames.size(); ++i)
+            out[i] = d->mimeTypeForFileExtension(fileNames.at(i));
+        return result;
+    }
+
+    std::atomic<qsizetype> next = 0;
+    const auto classify = [&] {
+        for (qsizetype i = next++; i < fileNames.size(); i = next++)
+            out[i] = d->mimeTypeForFile(fileNames.at(i), QFileInfo(fileNames.at(i)), mode);
+    };
+
+#if QT_CONFIG(thread)
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const qsizetype helperCount = qMin(qsizetype(pool->maxThreadCount()), fileNames.size()) - 1;
+    QSemaphore done;
+    std::vector<std::unique_ptr<QRunnable>> helpers;
+    for (qsizetype i = 0; i < helperCount; ++i) {
+        auto &helper = helpers.emplace_back(QRunnable::create([&] { classify(); done.release(); }));
+        helper->setAutoDelete(false);
+        pool->start(helper.get());
+    }
+    classify();
+
+    // Helpers that did not get a thread yet are not needed anymore.
+    int running = 0;
+    for (const auto &helper : helpers) {
+        if (!pool->tryTake(helper.get()))
+            ++running;
+    }
+    done.acquire(running);
+#else
+    classify();
+#endif
+    return result;
+}
+
 /*!
     Returns the MIME types for the file name \a fileName.
 
@@ -38,6 +38,8 @@ public:
     QMimeType mimeTypeForFile(const QString &fileName, MatchMode mode = MatchDefault) const;
     QMimeType mimeTypeForFile(const QFileInfo &fileInfo, MatchMode mode = MatchDefault) const;
     QList<QMimeType> mimeTypesForFileName(const QString &fileName) const;
+    QList<QMimeType> mimeTypesForFiles(const QStringList &fileNames,
+                                       MatchMode mode = MatchDefault) const;
 
     QMimeType mimeTypeForData(const QByteArray &data) const;
     QMimeType mimeTypeForData(QIODevice *device) const;
@@ -60,7 +60,6 @@ public:
     QMimeType mimeTypeForFileNameAndData(const QString &fileName, QIODevice *device);
     QMimeType mimeTypeForFileExtension(const QString &fileName);
     QMimeType mimeTypeForData(QIODevice *device);
-    QMimeType mimeTypeForFile(const QString &fileName, const QFileInfo &fileInfo, QMimeDatabase::MatchMode mode);
     QMimeType findByData(const QByteArray &data, int *priorityPtr);
     QStringList mimeTypeForFileName(const QString &fileName);
     QMimeGlobMatchResult findByFileName(const QString &fileName);
@@ -74,6 +73,9 @@ public:
     QStringList listAliases(const QString &mimeName);
     bool mimeInherits(const QString &mime, const QString &parent);
 
+    // Locks the mutex, but not while reading the file.
+    QMimeType mimeTypeForFile(const QString &fileName, const QFileInfo &fileInfo, QMimeDatabase::MatchMode mode);
+
 private:
     using Providers = std::vector<std::unique_ptr<QMimeProviderBase>>;
     const Providers &providers();
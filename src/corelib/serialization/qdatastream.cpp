@@ -1422,6 +1422,109 @@ int QDataStream::skipRawData(int len)
     return skipResult;
 }
 
+/*!
+    \internal
+
+    Returns whether elements of \a elementSize bytes are stored in \a s in
+    their in-memory representation, modulo byte order. That isn't the case
+    for floating point numbers whose precision differs from the stream's
+    floatingPointPrecision(), nor for 64-bit integers in streams older than
+    Qt 3.3, which store them as two 32-bit halves.
+*/
+bool QtPrivate::canStreamAsBlock(const QDataStream &s, qsizetype elementSize,
+                                 bool isFloatingPoint) noexcept
+{
+    if (isFloatingPoint && s.version() >= QDataStream::Qt_4_6) {
+        const qsizetype streamSize =
+                s.floatingPointPrecision() == QDataStream::DoublePrecision ? 8 : 4;
+        return elementSize == streamSize;
+    }
+    return elementSize != 8 || s.version() >= QDataStream::Qt_3_3;
+}
+
+static void swapElements(const void *source, qsizetype count, qsizetype elementSize, void *dest)
+{
+    switch (elementSize) {
+    case 2:
+        qbswap<2>(source, count, dest);
+        break;
+    case 4:
+        qbswap<4>(source, count, dest);
+        break;
+    case 8:
+        qbswap<8>(source, count, dest);
+        break;
+    default:
+        Q_UNREACHABLE();
+    }
+}
+
+static bool needsSwap(const QDataStream &s, qsizetype elementSize)
+{
+    return elementSize > 1
+            && s.byteOrder() != QDataStream::ByteOrder(QSysInfo::ByteOrder);
+}
+
+/*!
+    \internal
+
+    Reads \a count elements of \a elementSize bytes into \a data with a
+    single read per megabyte, converting them to host byte order in place.
+    Returns \c false if the stream ran out of data.
+*/
+bool QtPrivate::readBlockOfElements(QDataStream &s, void *data, qsizetype count,
+                                    qsizetype elementSize)
+{
+    constexpr qsizetype MaxChunk = 1 << 20;
+    char *ptr = static_cast<char *>(data);
+    qsizetype remaining = count * elementSize;
+    while (remaining > 0) {
+        const int len = int(qMin(remaining, MaxChunk));
+        if (s.readRawData(ptr, len) != len)
+            return false;
+        ptr += len;
+        remaining -= len;
+    }
+    if (needsSwap(s, elementSize))
+        swapElements(data, count, elementSize, data);
+    return true;
+}
+
+/*!
+    \internal
+
+    Writes \a count elements of \a elementSize bytes from \a data. Elements
+    are written with a single write when no byte swapping is required, and
+    are otherwise swapped into a bounded buffer in batches.
+*/
+void QtPrivate::writeBlockOfElements(QDataStream &s, const void *data, qsizetype count,
+                                     qsizetype elementSize)
+{
+    const char *ptr = static_cast<const char *>(data);
+    qsizetype remaining = count * elementSize;
+
+    if (!needsSwap(s, elementSize)) {
+        while (remaining > 0 && s.status() == QDataStream::Ok) {
+            const int len = int(qMin(remaining, qsizetype(std::numeric_limits<int>::max())));
+            if (s.writeRawData(ptr, len) != len)
+                return;
+            ptr += len;
+            remaining -= len;
+        }
+        return;
+    }
+
+    alignas(8) char buffer[16384];
+    while (remaining > 0 && s.status() == QDataStream::Ok) {
+        const qsizetype len = qMin(remaining, qsizetype(sizeof(buffer)));
+        swapElements(ptr, len / elementSize, elementSize, buffer);
+        if (s.writeRawData(buffer, int(len)) != len)
+            return;
+        ptr += len;
+        remaining -= len;
+    }
+}
+
 /*!
     \fn template <class T1, class T2> QDataStream &operator<<(QDataStream &out, const std::pair<T1, T2> &pair)
     \since 6.0
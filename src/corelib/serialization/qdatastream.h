@@ -235,6 +235,53 @@ QDataStream &readArrayBasedContainer(QDataStream &s, Container &c)
     return s;
 }
 
+// Types whose QDataStream representation is their in-memory one, modulo byte
+// order, so that lists of them can be streamed as a single block.
+template <typename T>
+constexpr bool IsBulkStreamable =
+        std::disjunction_v<std::is_same<T, qint8>, std::is_same<T, quint8>, std::is_same<T, char>,
+                           std::is_same<T, qint16>, std::is_same<T, quint16>,
+                           std::is_same<T, char16_t>, std::is_same<T, qint32>,
+                           std::is_same<T, quint32>, std::is_same<T, char32_t>,
+                           std::is_same<T, qint64>, std::is_same<T, quint64>,
+                           std::is_same<T, float>, std::is_same<T, double>>;
+
+Q_CORE_EXPORT bool canStreamAsBlock(const QDataStream &s, qsizetype elementSize,
+                                    bool isFloatingPoint) noexcept;
+Q_CORE_EXPORT bool readBlockOfElements(QDataStream &s, void *data, qsizetype count,
+                                       qsizetype elementSize);
+Q_CORE_EXPORT void writeBlockOfElements(QDataStream &s, const void *data, qsizetype count,
+                                        qsizetype elementSize);
+
+template <typename T>
+QDataStream &readBulkStreamableList(QDataStream &s, QList<T> &c)
+{
+    if (!canStreamAsBlock(s, sizeof(T), std::is_floating_point_v<T>))
+        return readArrayBasedContainer(s, c);
+
+    StreamStateSaver stateSaver(&s);
+
+    c.clear();
+    quint32 n;
+    s >> n;
+
+    // Grow the list as the data arrives, so that a corrupt size doesn't
+    // allocate much more than what the stream actually contains.
+    constexpr qsizetype Step = (1 << 20) / sizeof(T);
+    qsizetype done = 0;
+    while (done < qsizetype(n)) {
+        const qsizetype chunk = qMin(qsizetype(n) - done, Step);
+        c.resize(done + chunk);
+        if (!readBlockOfElements(s, c.data() + done, chunk, sizeof(T))) {
+            c.clear();
+            break;
+        }
+        done += chunk;
+    }
+
+    return s;
+}
+
 template <typename Container>
 QDataStream &readListBasedContainer(QDataStream &s, Container &c)
 {
@@ -288,6 +335,18 @@ QDataStream &writeSequentialContainer(QDataStream &s, const Container &c)
     return s;
 }
 
+template <typename T>
+QDataStream &writeBulkStreamableList(QDataStream &s, const QList<T> &c)
+{
+    if (!canStreamAsBlock(s, sizeof(T), std::is_floating_point_v<T>))
+        return writeSequentialContainer(s, c);
+
+    s << quint32(c.size());
+    writeBlockOfElements(s, c.constData(), c.size(), sizeof(T));
+
+    return s;
+}
+
 template <typename Container>
 QDataStream &writeAssociativeContainer(QDataStream &s, const Container &c)
 {
@@ -412,13 +471,19 @@ operator>>(QDataStream &s, T &t)
 template<typename T>
 inline QDataStreamIfHasIStreamOperatorsContainer<QList<T>, T> operator>>(QDataStream &s, QList<T> &v)
 {
-    return QtPrivate::readArrayBasedContainer(s, v);
+    if constexpr (QtPrivate::IsBulkStreamable<T>)
+        return QtPrivate::readBulkStreamableList(s, v);
+    else
+        return QtPrivate::readArrayBasedContainer(s, v);
 }
 
 template<typename T>
 inline QDataStreamIfHasOStreamOperatorsContainer<QList<T>, T> operator<<(QDataStream &s, const QList<T> &v)
 {
-    return QtPrivate::writeSequentialContainer(s, v);
+    if constexpr (QtPrivate::IsBulkStreamable<T>)
+        return QtPrivate::writeBulkStreamableList(s, v);
+    else
+        return QtPrivate::writeSequentialContainer(s, v);
 }
 
 template <typename T>
@@ -71,6 +71,27 @@ const char *QRingBuffer::readPointerAtPosition(qint64 pos, qint64 &length) const
     return nullptr;
 }
 
+/*!
+    \internal
+
+    Stores up to \a maxCount consecutive data blocks from the start of the
+    buffer in \a blocks, for use with vectored I/O, and returns the number of
+    blocks stored.
+*/
+qsizetype QRingBuffer::readPointers(QByteArrayView *blocks, qsizetype maxCount) const
+{
+    qsizetype count = 0;
+    if (bufferSize == 0)
+        return count;
+    for (const QRingChunk &chunk : buffers) {
+        if (count == maxCount)
+            break;
+        if (chunk.size() > 0)
+            blocks[count++] = QByteArrayView(chunk.data(), chunk.size());
+    }
+    return count;
+}
+
 void QRingBuffer::free(qint64 bytes)
 {
     Q_ASSERT(bytes <= bufferSize);
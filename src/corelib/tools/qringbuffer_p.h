@@ -157,6 +157,7 @@ public:
     }
 
     Q_CORE_EXPORT const char *readPointerAtPosition(qint64 pos, qint64 &length) const;
+    Q_CORE_EXPORT qsizetype readPointers(QByteArrayView *blocks, qsizetype maxCount) const;
     Q_CORE_EXPORT void free(qint64 bytes);
     Q_CORE_EXPORT char *reserve(qint64 bytes);
     Q_CORE_EXPORT char *reserveFront(qint64 bytes);
@@ -432,6 +432,10 @@
 #include "qabstractsocket_p.h"
 
 #include "private/qhostinfo_p.h"
+#if defined(Q_OS_UNIX)
+#include "private/qnativesocketengine_p.h"
+#include <private/qcore_unix_p.h>
+#endif
 
 #include <qabstracteventdispatcher.h>
 #include <qhostaddress.h>
@@ -709,9 +713,31 @@ bool QAbstractSocketPrivate::canWriteNotification()
     qDebug("QAbstractSocketPrivate::canWriteNotification() flushing");
 #endif
 
+    // data written while corked is held back until uncork()
+    if (corkCount && state == QAbstractSocket::ConnectedState) {
+        if (socketEngine)
+            socketEngine->setWriteNotificationEnabled(false);
+        return false;
+    }
+
     return writeToSocket();
 }
 
+/*! \internal
+
+    Flushes the data held back while the socket was corked, once the last
+    cork is released.
+*/
+void QAbstractSocketPrivate::corkStateChanged()
+{
+    if (corkCount || !socketEngine || writeBuffer.isEmpty())
+        return;
+    if (state == QAbstractSocket::ConnectedState)
+        writeToSocket();
+    if (socketEngine && !writeBuffer.isEmpty())
+        socketEngine->setWriteNotificationEnabled(true);
+}
+
 /*! \internal
 
     Slot connected to a notification of connection status
@@ -731,7 +757,9 @@ void QAbstractSocketPrivate::connectionNotification()
 
 /*! \internal
 
-    Writes one pending data block in the write buffer to the socket.
+    Writes pending data in the write buffer to the socket. Consecutive
+    blocks are gathered into a single system call where the socket engine
+    supports it.
 
     It is usually invoked by canWriteNotification after one or more
     calls to write().
@@ -759,11 +787,14 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
-    qint64 nextSize = writeBuffer.nextDataBlockSize();
-    const char *ptr = writeBuffer.readPointer();
-
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+    // Attempt to write all buffered blocks at once.
+    QByteArrayView blocks[256];
+    const qsizetype count = writeBuffer.readPointers(blocks, std::size(blocks));
+    qint64 written = Q_INT64_C(0);
+    if (count > 1)
+        written = socketEngine->writeVector(blocks, int(count));
+    else if (count == 1)
+        written = socketEngine->write(blocks[0].data(), blocks[0].size());
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -812,6 +843,37 @@ bool QAbstractSocketPrivate::flush()
     return dataWasWritten;
 }
 
+/*! \internal
+
+    Returns the descriptor of a connected TCP socket, so that
+    QIODevice::transferTo() can send data to it without copying it into the
+    write buffer. Any data that is already buffered is written out first; if
+    that is not possible without blocking, -1 is returned so that the new data
+    is queued behind it.
+
+    Only sockets using the native socket engine qualify, proxies may need to
+    see the data.
+*/
+int QAbstractSocketPrivate::transferTargetDescriptor()
+{
+#if defined(Q_OS_UNIX)
+    if (socketType != QAbstractSocket::TcpSocket || state != QAbstractSocket::ConnectedState
+        || !qobject_cast<QNativeSocketEngine *>(socketEngine) || !socketEngine->isValid()) {
+        return -1;
+    }
+
+    flush();
+    if (!writeBuffer.isEmpty())
+        return -1;
+
+    // Unlike send(), sendfile() has no MSG_NOSIGNAL.
+    qt_ignore_sigpipe();
+    return int(socketEngine->socketDescriptor());
+#else
+    return -1;
+#endif
+}
+
 #ifndef QT_NO_NETWORKPROXY
 /*! \internal
 
@@ -2426,7 +2488,7 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
         return -1;
     }
 
-    if (!d->isBuffered && d->socketType == TcpSocket
+    if (!d->isBuffered && d->socketType == TcpSocket && !d->corkCount
         && d->socketEngine && d->writeBuffer.isEmpty()) {
         // This code is for the new Unbuffered QTcpSocket use case
         qint64 written = size ? d->socketEngine->write(data, size) : Q_INT64_C(0);
@@ -2468,7 +2530,7 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
     d->write(data, size);
     qint64 written = size;
 
-    if (d->socketEngine && !d->writeBuffer.isEmpty())
+    if (d->socketEngine && !d->writeBuffer.isEmpty() && !d->corkCount)
         d->socketEngine->setWriteNotificationEnabled(true);
 
 #if defined (QABSTRACTSOCKET_DEBUG)
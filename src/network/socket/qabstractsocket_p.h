@@ -94,6 +94,8 @@ public:
 
     void resetSocketLayer();
     virtual bool flush();
+    int transferTargetDescriptor() override;
+    void corkStateChanged() override;
 
     bool initSocketLayer(QAbstractSocket::NetworkLayerProtocol protocol);
     virtual void configureCreatedSocket();
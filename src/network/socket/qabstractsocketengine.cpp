@@ -109,6 +109,31 @@ void QAbstractSocketEngine::setError(QAbstractSocket::SocketError error, const Q
     d->socketErrorString = errorString;
 }
 
+/*!
+    \internal
+
+    Writes the \a count data blocks in \a blocks, in order, and returns the
+    total number of bytes written, or -1 on error. Like write(), this may
+    write less than all of the data.
+
+    The base implementation calls write() for each block and stops at the
+    first short write. Engines that can gather several blocks into a single
+    system call override it.
+*/
+qint64 QAbstractSocketEngine::writeVector(const QByteArrayView *blocks, int count)
+{
+    qint64 total = 0;
+    for (int i = 0; i < count; ++i) {
+        const qint64 written = write(blocks[i].data(), blocks[i].size());
+        if (written < 0)
+            return total ? total : written;
+        total += written;
+        if (written < blocks[i].size())
+            break;
+    }
+    return total;
+}
+
 void QAbstractSocketEngine::setReceiver(QAbstractSocketEngineReceiver *receiver)
 {
     d_func()->receiver = receiver;
@@ -89,6 +89,7 @@ public:
 #if defined(QT_LOCALSOCKET_TCP)
     QLocalUnixSocket* tcpSocket;
     bool ownsTcpSocket;
+    void corkStateChanged() override;
     void setSocket(QLocalUnixSocket*);
     QString generateErrorString(QLocalSocket::LocalSocketError, const QString &function) const;
     void setErrorAndEmit(QLocalSocket::LocalSocketError, const QString &function);
@@ -108,6 +109,8 @@ public:
     QLocalSocket::LocalSocketError error;
 #else
     QLocalUnixSocket unixSocket;
+    int transferTargetDescriptor() override;
+    void corkStateChanged() override;
     QString generateErrorString(QLocalSocket::LocalSocketError, const QString &function) const;
     void setErrorAndEmit(QLocalSocket::LocalSocketError, const QString &function);
     void _q_stateChanged(QAbstractSocket::SocketState newState);
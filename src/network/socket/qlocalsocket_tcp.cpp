@@ -46,6 +46,16 @@ void QLocalSocketPrivate::setSocket(QLocalUnixSocket* socket)
                q, SLOT(_q_errorOccurred(QAbstractSocket::SocketError)));
     q->connect(tcpSocket, SIGNAL(readChannelFinished()), q, SIGNAL(readChannelFinished()));
     tcpSocket->setParent(q);
+    if (corkCount)
+        tcpSocket->cork();
+}
+
+void QLocalSocketPrivate::corkStateChanged()
+{
+    if (corkCount)
+        tcpSocket->cork();
+    else
+        tcpSocket->uncork();
 }
 
 void QLocalSocketPrivate::_q_errorOccurred(QAbstractSocket::SocketError socketError)
@@ -78,6 +78,20 @@ void QLocalSocketPrivate::init()
     unixSocket.setParent(q);
 }
 
+int QLocalSocketPrivate::transferTargetDescriptor()
+{
+    // All writes go straight through to the underlying socket.
+    return QIODevicePrivate::get(&unixSocket)->transferTargetDescriptor();
+}
+
+void QLocalSocketPrivate::corkStateChanged()
+{
+    if (corkCount)
+        unixSocket.cork();
+    else
+        unixSocket.uncork();
+}
+
 void QLocalSocketPrivate::_q_errorOccurred(QAbstractSocket::SocketError socketError)
 {
     Q_Q(QLocalSocket);
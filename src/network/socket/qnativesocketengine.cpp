@@ -882,6 +882,19 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+/*!
+    Writes the \a count blocks in \a blocks to the socket with a single
+    system call. Returns the number of bytes written, or -1 if an error
+    occurred.
+*/
+qint64 QNativeSocketEngine::writeVector(const QByteArrayView *blocks, int count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeVector(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeVector(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWriteVector(blocks, count);
+}
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
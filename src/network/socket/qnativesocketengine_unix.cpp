@@ -1306,6 +1306,55 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 
     return qint64(writtenBytes);
 }
+
+qint64 QNativeSocketEnginePrivate::nativeWriteVector(const QByteArrayView *blocks, int count)
+{
+    Q_Q(QNativeSocketEngine);
+
+#ifdef IOV_MAX
+    constexpr int MaxBlocks = IOV_MAX < 1024 ? IOV_MAX : 1024;
+#else
+    constexpr int MaxBlocks = 16;
+#endif
+    count = qMin(count, MaxBlocks);
+    QVarLengthArray<iovec, 64> vec(count);
+    for (int i = 0; i < count; ++i) {
+        vec[i].iov_base = const_cast<char *>(blocks[i].data());
+        vec[i].iov_len = size_t(blocks[i].size());
+    }
+
+    msghdr msg = {};
+    msg.msg_iov = vec.data();
+    msg.msg_iovlen = count;
+    ssize_t writtenBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+
+    if (writtenBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            writtenBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+        case EAGAIN:
+            writtenBytes = 0;
+            break;
+        case EMSGSIZE:
+            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+            break;
+        default:
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWriteVector(%d blocks) == %i", count,
+           (int) writtenBytes);
+#endif
+
+    return qint64(writtenBytes);
+}
+
 /*
 */
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
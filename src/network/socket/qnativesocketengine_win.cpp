@@ -1381,6 +1381,39 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
     return ret;
 }
 
+qint64 QNativeSocketEnginePrivate::nativeWriteVector(const QByteArrayView *blocks, int count)
+{
+    Q_Q(QNativeSocketEngine);
+
+    QVarLengthArray<WSABUF, 64> bufs(count);
+    for (int i = 0; i < count; ++i) {
+        bufs[i].buf = const_cast<char *>(blocks[i].data());
+        bufs[i].len = ULONG(qMin<qsizetype>(blocks[i].size(), ULONG_MAX));
+    }
+
+    DWORD bytesWritten = 0;
+    if (::WSASend(socketDescriptor, bufs.data(), DWORD(count), &bytesWritten, 0, 0, 0)
+            != SOCKET_ERROR) {
+        return qint64(bytesWritten);
+    }
+
+    const int err = WSAGetLastError();
+    switch (err) {
+    case WSAEWOULDBLOCK:
+    case WSAENOBUFS:
+        return 0;
+    case WSAECONNRESET:
+    case WSAECONNABORTED:
+        WS_ERROR_DEBUG(err);
+        setError(QAbstractSocket::NetworkError, WriteErrorString);
+        q->close();
+        return -1;
+    default:
+        WS_ERROR_DEBUG(err);
+        return 0;
+    }
+}
+
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxLength)
 {
     qint64 ret = -1;
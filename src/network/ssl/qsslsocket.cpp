@@ -2848,6 +2848,17 @@ bool QSslSocketPrivate::flush()
     return plainSocket && plainSocket->flush();
 }
 
+/*!
+    \internal
+
+    The data must pass through the TLS backend, never write it to the socket
+    directly.
+*/
+int QSslSocketPrivate::transferTargetDescriptor()
+{
+    return -1;
+}
+
 /*!
     \internal
 */
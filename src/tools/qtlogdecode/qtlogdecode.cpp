@@ -0,0 +1,171 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QTimeZone>
+#include <QtEndian>
+
+#include <private/qlogging_p.h>
+
+#include <stdio.h>
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+namespace {
+// Reads the binary log format described in qlogging_p.h.
+class BinaryLogReader
+{
+public:
+    explicit BinaryLogReader(const QByteArray &data) : data(data) { }
+
+    template <typename T> bool read(T *value)
+    {
+        if (data.size() - pos < qsizetype(sizeof(T)))
+            return false;
+        *value = qFromLittleEndian<T>(data.constData() + pos);
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool read(QByteArray *value, quint32 size)
+    {
+        if (data.size() - pos < qsizetype(size))
+            return false;
+        *value = data.mid(pos, size);
+        pos += size;
+        return true;
+    }
+
+    bool atEnd() const { return pos == data.size(); }
+
+private:
+    QByteArray data;
+    qsizetype pos = 0;
+};
+
+struct Message
+{
+    quint8 type;
+    qint64 elapsed;
+    quint64 threadId;
+    quint32 category;
+    quint32 file;
+    quint32 function;
+    qint32 line;
+    QByteArray text;
+};
+} // unnamed namespace
+
+static int decode(const QByteArray &data, FILE *out)
+{
+    BinaryLogReader reader(data);
+    QByteArray magic;
+    quint32 version;
+    qint64 startTime;
+    if (!reader.read(&magic, sizeof(QBinaryLogFormat::Magic))
+            || magic != QByteArrayView(QBinaryLogFormat::Magic, sizeof(QBinaryLogFormat::Magic))) {
+        fprintf(stderr, "qtlogdecode: not a Qt binary log\n");
+        return 1;
+    }
+    if (!reader.read(&version) || version != QBinaryLogFormat::Version) {
+        fprintf(stderr, "qtlogdecode: unsupported binary log version\n");
+        return 1;
+    }
+    if (!reader.read(&startTime)) {
+        fprintf(stderr, "qtlogdecode: truncated header\n");
+        return 1;
+    }
+
+    QHash<quint32, QByteArray> strings;
+    const auto string = [&strings](quint32 id) -> const char * {
+        if (id == 0)
+            return nullptr;
+        const auto it = strings.constFind(id);
+        return it == strings.cend() ? "?" : it->constData();
+    };
+
+    while (!reader.atEnd()) {
+        quint8 recordType;
+        if (!reader.read(&recordType))
+            break;
+        if (recordType == QBinaryLogFormat::StringRecord) {
+            quint32 id, size;
+            QByteArray value;
+            if (!reader.read(&id) || !reader.read(&size) || !reader.read(&value, size))
+                break;
+            strings.insert(id, value);
+        } else if (recordType == QBinaryLogFormat::MessageRecord) {
+            Message m;
+            quint32 size;
+            if (!reader.read(&m.type) || !reader.read(&m.elapsed) || !reader.read(&m.threadId)
+                    || !reader.read(&m.category) || !reader.read(&m.file)
+                    || !reader.read(&m.function) || !reader.read(&m.line)
+                    || !reader.read(&size) || !reader.read(&m.text, size)) {
+                break;
+            }
+
+            const QMessageLogContext context(string(m.file), m.line, string(m.function),
+                                             string(m.category));
+            const QString formatted = qFormatLogMessage(QtMsgType(m.type), context,
+                                                        QString::fromUtf8(m.text));
+            if (formatted.isNull())
+                continue;
+            const QDateTime time =
+                    QDateTime::fromMSecsSinceEpoch(startTime + m.elapsed / 1000000, QTimeZone::UTC);
+            fprintf(out, "%s %llu %s\n", qPrintable(time.toString(Qt::ISODateWithMs)),
+                    static_cast<unsigned long long>(m.threadId), qPrintable(formatted));
+        } else {
+            fprintf(stderr, "qtlogdecode: unknown record type %d\n", recordType);
+            return 1;
+        }
+    }
+
+    if (!reader.atEnd()) {
+        // The application may have crashed while writing; keep what we have.
+        fprintf(stderr, "qtlogdecode: the log ends with an incomplete record\n");
+        return 2;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationVersion(QLatin1StringView(QT_VERSION_STR));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+            u"Converts a log written with QT_LOGGING_BINARY to text. Each line starts "
+            "with the time (UTC) and the thread id of the message, followed by the message "
+            "formatted according to the message pattern."_s);
+    parser.addHelpOption();
+    parser.addVersionOption();
+    const QCommandLineOption patternOption(
+            u"pattern"_s,
+            u"Formats messages with <pattern>, as in qSetMessagePattern()."_s, u"pattern"_s);
+    parser.addOption(patternOption);
+    parser.addPositionalArgument(u"file"_s, u"The binary log to decode."_s);
+    parser.process(app);
+
+    const QStringList files = parser.positionalArguments();
+    if (files.size() != 1)
+        parser.showHelp(1);
+
+    QFile file(files.constFirst());
+    if (!file.open(QIODevice::ReadOnly)) {
+        fprintf(stderr, "qtlogdecode: cannot open %s: %s\n", qPrintable(file.fileName()),
+                qPrintable(file.errorString()));
+        return 1;
+    }
+
+    if (parser.isSet(patternOption))
+        qSetMessagePattern(parser.value(patternOption));
+
+    return decode(file.readAll(), stdout);
+}
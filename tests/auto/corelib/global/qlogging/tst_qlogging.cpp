@@ -9,6 +9,7 @@
 # include <QtCore/QProcess>
 #endif
 #include <QtTest/QTest>
+#include <QTemporaryDir>
 #include <QList>
 #include <QMap>
 
@@ -37,6 +38,8 @@ private slots:
     void qMessagePattern_data();
     void qMessagePattern();
     void setMessagePattern();
+    void asyncStderr();
+    void binaryLog();
 
     void formatLogMessage_data();
     void formatLogMessage();
@@ -914,6 +917,88 @@ void tst_qmessagehandler::setMessagePattern()
 #endif // QT_CONFIG(process)
 }
 
+void tst_qmessagehandler::asyncStderr()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This test requires QProcess support");
+#else
+#ifdef Q_OS_ANDROID
+    QSKIP("This test crashes on Android");
+#endif
+
+    QProcess process;
+    const QString appExe(backtraceHelperPath());
+
+    QProcessEnvironment environment = m_baseEnvironment;
+    environment.insert("QT_LOGGING_ASYNC", "1");
+    process.setProcessEnvironment(environment);
+
+    process.start(appExe);
+    QVERIFY2(process.waitForStarted(), qPrintable(
+        QString::fromLatin1("Could not start %1: %2").arg(appExe, process.errorString())));
+    process.waitForFinished();
+
+    // everything is written by the time the application exits, in order
+    QByteArray output = process.readAllStandardError();
+    QByteArray expected = "static constructor\n"
+            "[debug] qDebug\n"
+            "[info] qInfo\n"
+            "[warning] qWarning\n"
+            "[critical] qCritical\n"
+            "[warning] qDebug with category\n";
+#ifdef Q_OS_WIN
+    output.replace("\r\n", "\n");
+#endif
+    QCOMPARE(QString::fromLatin1(output), QString::fromLatin1(expected));
+#endif // QT_CONFIG(process)
+}
+
+void tst_qmessagehandler::binaryLog()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This test requires QProcess support");
+#else
+#ifdef Q_OS_ANDROID
+    QSKIP("This test crashes on Android");
+#endif
+
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    const QString logFileName = dir.filePath("log.bin");
+
+    QProcess process;
+    const QString appExe(backtraceHelperPath());
+
+    QProcessEnvironment environment = m_baseEnvironment;
+    environment.insert("QT_LOGGING_BINARY", logFileName);
+    process.setProcessEnvironment(environment);
+
+    process.start(appExe);
+    QVERIFY2(process.waitForStarted(), qPrintable(
+        QString::fromLatin1("Could not start %1: %2").arg(appExe, process.errorString())));
+    process.waitForFinished();
+
+    // nothing goes to stderr
+    QVERIFY(!process.readAllStandardError().contains("qWarning"));
+
+    QFile logFile(logFileName);
+    QVERIFY(logFile.open(QIODevice::ReadOnly));
+    const QByteArray log = logFile.readAll();
+    QVERIFY(log.startsWith("QTLOGBIN"));
+
+    // the message pattern is not applied, and messages from static
+    // destructors are still recorded
+    for (const char *message : { "static constructor", "qDebug", "qInfo", "qWarning",
+                                 "qCritical", "qDebug with category", "qDebug2",
+                                 "from_a_function 34", "static destructor" }) {
+        QVERIFY2(log.contains(message), message);
+    }
+    QVERIFY(!log.contains("[warning]"));
+    // category names are stored once, not with every message
+    QCOMPARE(log.count("default"), 1);
+#endif // QT_CONFIG(process)
+}
+
 Q_DECLARE_METATYPE(QtMsgType)
 
 void tst_qmessagehandler::formatLogMessage_data()
@@ -20,6 +20,9 @@
 #include <QStandardPaths>
 #include <QTemporaryDir>
 #include <QTemporaryFile>
+#if QT_CONFIG(future)
+#include <QFuture>
+#endif
 
 #include <private/qabstractfileengine_p.h>
 #include <private/qfsfileengine_p.h>
@@ -154,6 +157,12 @@ private slots:
     void readAll_data();
     void readAll();
     void readAllBuffer();
+#if QT_CONFIG(future)
+    void readAsync_data();
+    void readAsync();
+    void writeAsync();
+    void asyncInvalidArguments();
+#endif
     void readAllStdin();
     void readLineStdin();
     void readLineStdin_lineByLine();
@@ -923,6 +932,91 @@ void tst_QFile::readAll()
     QCOMPARE(a, b);
 }
 
+#if QT_CONFIG(future)
+void tst_QFile::readAsync_data()
+{
+    QTest::addColumn<qint64>("offset");
+    QTest::addColumn<qint64>("maxSize");
+
+    QTest::newRow("all") << qint64(0) << qint64(-1);
+    QTest::newRow("head") << qint64(0) << qint64(100);
+    QTest::newRow("middle") << qint64(1000) << qint64(3 * 1024 * 1024);
+    QTest::newRow("tail") << qint64(4 * 1024 * 1024 - 10) << qint64(-1);
+    QTest::newRow("past-end") << qint64(5 * 1024 * 1024) << qint64(-1);
+    QTest::newRow("empty") << qint64(0) << qint64(0);
+}
+
+void tst_QFile::readAsync()
+{
+    QFETCH(qint64, offset);
+    QFETCH(qint64, maxSize);
+
+    // larger than a chunk, so that the data is read in several steps
+    QByteArray data(4 * 1024 * 1024, Qt::Uninitialized);
+    for (qsizetype i = 0; i < data.size(); ++i)
+        data[i] = char(i % 251);
+
+    const QString fileName = u"readAsync.bin"_s;
+    QFile file(fileName);
+    QVERIFY2(file.open(QIODevice::WriteOnly), msgOpenFailed(file).constData());
+    QCOMPARE(file.write(data), data.size());
+    file.close();
+
+    QFuture<QByteArray> future = file.readAsync(offset, maxSize);
+    future.waitForFinished();
+    QVERIFY(!future.isCanceled());
+    QCOMPARE(future.result(), data.mid(offset, maxSize));
+    QVERIFY(!file.isOpen());
+}
+
+void tst_QFile::writeAsync()
+{
+    const QString fileName = u"writeAsync.bin"_s;
+    QFile::remove(fileName);
+    QFile file(fileName);
+
+    const QByteArray big(3 * 1024 * 1024, 'a');
+    QFuture<qint64> future = file.writeAsync(big);
+    QCOMPARE(future.result(), big.size());
+
+    // overwrites in place without truncating
+    future = file.writeAsync("bbbb", 10);
+    QCOMPARE(future.result(), 4);
+
+    // appends
+    future = file.writeAsync("cc");
+    QCOMPARE(future.result(), 2);
+
+    QByteArray expected = big;
+    expected.replace(10, 4, "bbbb");
+    expected.append("cc");
+    QVERIFY2(file.open(QIODevice::ReadOnly), msgOpenFailed(file).constData());
+    QCOMPARE(file.readAll(), expected);
+}
+
+void tst_QFile::asyncInvalidArguments()
+{
+    QFile file(u"asyncInvalidArguments.bin"_s);
+
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QFile::readAsync: Called with offset < 0 or maxSize < -1");
+    QFuture<QByteArray> readFuture = file.readAsync(-1);
+    QVERIFY(readFuture.isFinished());
+    QVERIFY(readFuture.isCanceled());
+
+    QTest::ignoreMessage(QtWarningMsg, "QFile::writeAsync: Called with offset < -1");
+    QFuture<qint64> writeFuture = file.writeAsync("x", -2);
+    QVERIFY(writeFuture.isFinished());
+    QVERIFY(writeFuture.isCanceled());
+
+    // the file does not exist
+    readFuture = QFile(u"nonexistent-file.bin"_s).readAsync();
+    readFuture.waitForFinished();
+    QVERIFY(readFuture.isCanceled());
+    QVERIFY(readFuture.results().isEmpty());
+}
+#endif // QT_CONFIG(future)
+
 void tst_QFile::readAllBuffer()
 {
     QString fileName = QLatin1String("readAllBuffer.txt");
@@ -35,6 +35,13 @@ private slots:
     void skipAfterPeek_data();
     void skipAfterPeek();
 
+    void transferTo_data();
+    void transferTo();
+    void transferToPartialTarget();
+    void transferToFile_data();
+    void transferToFile();
+    void transferToLocalSocket();
+
     void transaction_data();
     void transaction();
 
@@ -711,6 +718,186 @@ void tst_QIODevice::skipAfterPeek()
     QCOMPARE(readSoFar, data.size());
 }
 
+void tst_QIODevice::transferTo_data()
+{
+    QTest::addColumn<bool>("sequential");
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<qint64>("maxSize");
+
+    const QByteArray bigData(100000, 'a');
+    QTest::newRow("sequential/all") << true << bigData << qint64(-1);
+    QTest::newRow("sequential/part") << true << bigData << qint64(20000);
+    QTest::newRow("sequential/empty") << true << QByteArray() << qint64(-1);
+    QTest::newRow("random-access/all") << false << bigData << qint64(-1);
+    QTest::newRow("random-access/part") << false << bigData << qint64(20000);
+    QTest::newRow("random-access/empty") << false << QByteArray() << qint64(-1);
+}
+
+void tst_QIODevice::transferTo()
+{
+    QFETCH(bool, sequential);
+    QFETCH(QByteArray, data);
+    QFETCH(qint64, maxSize);
+
+    QScopedPointer<QIODevice> dev(sequential ? (QIODevice *) new SequentialReadBuffer(&data)
+                                             : (QIODevice *) new QBuffer(&data));
+    QVERIFY(dev->open(QIODevice::ReadOnly));
+    QCOMPARE(dev->peek(10), data.left(10));
+
+    QByteArray result;
+    QBuffer target(&result);
+    QVERIFY(target.open(QIODevice::WriteOnly));
+
+    const qint64 expected = maxSize < 0 ? data.size() : qMin<qint64>(maxSize, data.size());
+    QCOMPARE(dev->transferTo(&target, maxSize), expected);
+    QCOMPARE(result, data.left(expected));
+    QCOMPARE(dev->readAll(), data.mid(expected));
+}
+
+// Accepts no more than a fixed number of bytes
+class LimitedWriteDevice : public QIODevice
+{
+public:
+    explicit LimitedWriteDevice(qint64 limit) : limit(limit) { }
+
+    bool isSequential() const override { return true; }
+    QByteArray written;
+
+protected:
+    qint64 readData(char *, qint64) override { return -1; }
+    qint64 writeData(const char *data, qint64 maxSize) override
+    {
+        maxSize = qMin(maxSize, limit - written.size());
+        written.append(data, maxSize);
+        return maxSize;
+    }
+
+private:
+    qint64 limit;
+};
+
+void tst_QIODevice::transferToPartialTarget()
+{
+    const QByteArray data(100000, 'b');
+    QBuffer source;
+    source.setData(data);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+
+    LimitedWriteDevice target(30000);
+    QVERIFY(target.open(QIODevice::WriteOnly));
+
+    QCOMPARE(source.transferTo(&target), qint64(30000));
+    QCOMPARE(target.written, data.left(30000));
+    QCOMPARE(source.pos(), qint64(30000));
+    QCOMPARE(source.readAll(), data.mid(30000));
+}
+
+void tst_QIODevice::transferToFile_data()
+{
+    QTest::addColumn<QIODevice::OpenMode>("sourceMode");
+    QTest::addColumn<QIODevice::OpenMode>("targetMode");
+    QTest::addColumn<bool>("transaction");
+
+    const QIODevice::OpenMode none = {};
+    QTest::newRow("plain") << none << none << false;
+    QTest::newRow("append") << none << QIODevice::OpenMode(QIODevice::Append) << false;
+    QTest::newRow("text-source") << QIODevice::OpenMode(QIODevice::Text) << none << false;
+    QTest::newRow("text-target") << none << QIODevice::OpenMode(QIODevice::Text) << false;
+    QTest::newRow("transaction") << none << none << true;
+}
+
+void tst_QIODevice::transferToFile()
+{
+    QFETCH(QIODevice::OpenMode, sourceMode);
+    QFETCH(QIODevice::OpenMode, targetMode);
+    QFETCH(bool, transaction);
+
+    QByteArray data;
+    for (int i = 0; i < 10000; ++i)
+        data += QByteArray::number(i) + '\n';
+
+    QFile source(QStringLiteral("transferTo-source.txt"));
+    QVERIFY2(source.open(QIODevice::ReadWrite | QIODevice::Truncate | sourceMode),
+             qPrintable(source.errorString()));
+    QCOMPARE(source.write(data), data.size());
+    QVERIFY(source.seek(0));
+    QCOMPARE(source.read(5), data.left(5));
+    if (transaction)
+        source.startTransaction();
+
+    QFile target(QStringLiteral("transferTo-target.txt"));
+    QVERIFY2(target.open(QIODevice::ReadWrite | QIODevice::Truncate | targetMode),
+             qPrintable(target.errorString()));
+    QCOMPARE(target.write("header\n"), qint64(7));
+
+    // On Windows, text mode changes the number of bytes on disk.
+    const bool checkPositions = !((sourceMode | targetMode) & QIODevice::Text);
+
+    QCOMPARE(source.transferTo(&target, 1000), qint64(1000));
+    if (checkPositions) {
+        QCOMPARE(source.pos(), qint64(1005));
+        QCOMPARE(target.pos(), qint64(1007));
+    }
+
+    QCOMPARE(source.transferTo(&target), qint64(data.size() - 1005));
+    QVERIFY(source.atEnd());
+    QCOMPARE(source.transferTo(&target), qint64(0));
+    if (checkPositions)
+        QCOMPARE(target.pos(), qint64(data.size() + 2));
+
+    QVERIFY(target.seek(0));
+    QCOMPARE(target.readAll(), "header\n" + data.mid(5));
+
+    if (transaction) {
+        source.rollbackTransaction();
+        QCOMPARE(source.readAll(), data.mid(5));
+    }
+}
+
+void tst_QIODevice::transferToLocalSocket()
+{
+#if !QT_CONFIG(localserver)
+    QSKIP("Local sockets are not supported on this platform");
+#else
+    QByteArray data;
+    for (int i = 0; i < 100000; ++i)
+        data += QByteArray::number(i) + '\n';
+
+    QFile source(QStringLiteral("transferTo-socket.txt"));
+    QVERIFY2(source.open(QIODevice::ReadWrite | QIODevice::Truncate),
+             qPrintable(source.errorString()));
+    QCOMPARE(source.write(data), data.size());
+    QVERIFY(source.seek(0));
+
+    const QString serverName = QStringLiteral("tst_qiodevice_transferTo_")
+                               + QString::number(QCoreApplication::applicationPid());
+    QLocalServer::removeServer(serverName);
+    QLocalServer server;
+    QVERIFY2(server.listen(serverName), qPrintable(server.errorString()));
+
+    QLocalSocket client;
+    client.connectToServer(serverName);
+    QVERIFY(client.waitForConnected(5000));
+    QVERIFY(server.waitForNewConnection(5000));
+    QLocalSocket *peer = server.nextPendingConnection();
+    QVERIFY(peer);
+
+    QByteArray received;
+    while (received.size() < data.size()) {
+        if (!source.atEnd()) {
+            QVERIFY(source.transferTo(&client) >= 0);
+            // The socket's write buffer must stay bounded.
+            QVERIFY(client.bytesToWrite() <= 5 * 16384);
+        }
+        client.flush();
+        if (peer->bytesAvailable() == 0)
+            QVERIFY(peer->waitForReadyRead(5000));
+        received += peer->readAll();
+    }
+    QCOMPARE(received, data);
+#endif
+}
+
 void tst_QIODevice::transaction_data()
 {
     QTest::addColumn<bool>("sequential");
@@ -32,6 +32,7 @@ private slots:
     void checkUnregisterResource();
     void compressedResource_data();
     void compressedResource();
+    void lookupAfterRegistration();
     void checkStructure_data();
     void checkStructure();
     void searchPath_data();
@@ -153,6 +154,26 @@ void tst_QResourceEngine::compressedResource()
 }
 
 
+void tst_QResourceEngine::lookupAfterRegistration()
+{
+    // Lookups are cached, including misses; registering and unregistering
+    // must be seen by the next lookup.
+    const QString fileName = QFINDTESTDATA("uncompressed.rcc");
+    for (int i = 0; i < 2; ++i) {
+        QVERIFY(!QResource("zero.txt").isValid());
+        QVERIFY(!QFile::exists(":/zero.txt"));
+
+        QVERIFY(QResource::registerResource(fileName));
+        QVERIFY(QResource("zero.txt").isValid());
+        QVERIFY(QFile::exists(":/zero.txt"));
+        QCOMPARE(QResource(":/zero.txt").size(), ZERO_FILE_LEN);
+
+        QVERIFY(QResource::unregisterResource(fileName));
+        QVERIFY(!QResource("zero.txt").isValid());
+        QVERIFY(!QFile::exists(":/zero.txt"));
+    }
+}
+
 void tst_QResourceEngine::checkStructure_data()
 {
     QTest::addColumn<QString>("pathName");
@@ -454,6 +475,21 @@ void tst_QResourceEngine::checkStructure()
         // check contents
         QCOMPARE(file.readAll(), contents);
 
+        // check reading parts out of order, which compressed resources
+        // only decompress as far as needed
+        {
+            QFile partial(pathName);
+            QVERIFY(partial.open(QFile::ReadOnly | QFile::Unbuffered));
+            const qint64 middle = contents.size() / 2;
+            QCOMPARE(partial.read(8), contents.left(8));
+            QVERIFY(partial.seek(middle));
+            QCOMPARE(partial.read(8), contents.mid(middle, 8));
+            QVERIFY(partial.seek(1));
+            QCOMPARE(partial.read(8), contents.mid(1, 8));
+            QVERIFY(partial.seek(middle));
+            QCOMPARE(partial.readAll(), contents.mid(middle));
+        }
+
         // check memory map too
         uchar *ptr = file.map(0, file.size(), QFile::MapPrivateOption);
         QVERIFY2(ptr, qPrintable(file.errorString()));
@@ -124,6 +124,7 @@ private slots:
     void testChildKeysAndGroups_data() { populateWithFormats(); }
     void testChildKeysAndGroups();
     void testUpdateRequestEvent();
+    void testWriteBehind();
     void testThreadSafety();
     void testEmptyData();
     void testEmptyKey();
@@ -2021,6 +2022,40 @@ void tst_QSettings::testUpdateRequestEvent()
     QDir::setCurrent(oldCur);
 }
 
+void tst_QSettings::testWriteBehind()
+{
+    qputenv("QT_SETTINGS_WRITE_BEHIND", "1");
+    auto restoreEnv = qScopeGuard([] { qunsetenv("QT_SETTINGS_WRITE_BEHIND"); });
+
+    const QString fileName = settingsPath("writeBehind.ini");
+    QFile::remove(fileName);
+
+    {
+        QSettings settings(fileName, QSettings::IniFormat);
+        settings.setValue("key1", 1);
+    }
+    // the pending change is visible before it reaches the disk
+    {
+        QSettings settings(fileName, QSettings::IniFormat);
+        QCOMPARE(settings.value("key1").toInt(), 1);
+        settings.setValue("key2", 2);
+    }
+    QTRY_VERIFY(QFileInfo(fileName).size() > 0);
+
+    {
+        QSettings settings(fileName, QSettings::IniFormat);
+        settings.setValue("key3", 3);
+        settings.sync();
+        QCOMPARE(settings.status(), QSettings::NoError);
+    }
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray contents = file.readAll();
+    QVERIFY(contents.contains("key1=1"));
+    QVERIFY(contents.contains("key2=2"));
+    QVERIFY(contents.contains("key3=3"));
+}
+
 const int NumIterations = 5;
 const int NumThreads = 4;
 int numThreadSafetyFailures;
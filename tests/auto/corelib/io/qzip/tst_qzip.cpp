@@ -17,8 +17,35 @@ private slots:
     void symlinks();
     void readTest();
     void createArchive();
+    void streamedEntries();
+    void parallelCompression();
+    void zip64ManyEntries();
 };
 
+namespace {
+// A sequential device, whose size is unknown to the writer
+class SequentialReader : public QIODevice
+{
+public:
+    explicit SequentialReader(const QByteArray &data) : data(data) { open(ReadOnly); }
+    bool isSequential() const override { return true; }
+
+protected:
+    qint64 readData(char *dest, qint64 maxSize) override
+    {
+        maxSize = qMin(maxSize, data.size() - offset);
+        memcpy(dest, data.constData() + offset, maxSize);
+        offset += maxSize;
+        return maxSize;
+    }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    QByteArray data;
+    qint64 offset = 0;
+};
+}
+
 void tst_QZip::basicUnpack()
 {
     QZipReader zip(QFINDTESTDATA("/testdata/test.zip"), QIODevice::ReadOnly);
@@ -112,5 +139,89 @@ void tst_QZip::createArchive()
     QCOMPARE(zip2.fileData("My Filename"), fileContents);
 }
 
+void tst_QZip::streamedEntries()
+{
+    QByteArray contents;
+    for (int i = 0; i < 20000; ++i)
+        contents += QByteArray::number(i) + '\n';
+
+    QBuffer buffer;
+    {
+        QZipWriter zip(&buffer);
+        QBuffer source(&contents);
+        zip.addFile("random-access", &source);
+        SequentialReader sequential(contents);
+        zip.addFile("sequential", &sequential);
+        SequentialReader empty{QByteArray()};
+        zip.addFile("empty", &empty);
+        QCOMPARE(zip.status(), QZipWriter::NoError);
+    }
+    QByteArray zipFile = buffer.buffer();
+
+    QBuffer buffer2(&zipFile);
+    QZipReader zip2(&buffer2);
+    const QList<QZipReader::FileInfo> files = zip2.fileInfoList();
+    QCOMPARE(files.size(), 3);
+    QCOMPARE(files.at(1).size, qint64(contents.size()));
+    QCOMPARE(zip2.fileData("random-access"), contents);
+    QCOMPARE(zip2.fileData("sequential"), contents);
+    QCOMPARE(zip2.fileData("empty"), QByteArray());
+
+    QBuffer out;
+    out.open(QIODevice::WriteOnly);
+    QVERIFY(zip2.fileData("sequential", &out));
+    QCOMPARE(out.data(), contents);
+    QVERIFY(!zip2.fileData("missing", &out));
+}
+
+void tst_QZip::parallelCompression()
+{
+    // large entries are compressed on a thread pool, but must keep their order
+    QList<QByteArray> contents;
+    for (int i = 0; i < 16; ++i)
+        contents.append(QByteArray(512 * 1024 + i, char('a' + i)));
+
+    QBuffer buffer;
+    {
+        QZipWriter zip(&buffer);
+        for (int i = 0; i < contents.size(); ++i) {
+            zip.addFile(QString::number(i), contents.at(i));
+            if (i == 7)
+                zip.addDirectory("dir");
+        }
+    }
+    QByteArray zipFile = buffer.buffer();
+
+    QBuffer buffer2(&zipFile);
+    QZipReader zip2(&buffer2);
+    const QList<QZipReader::FileInfo> files = zip2.fileInfoList();
+    QCOMPARE(files.size(), contents.size() + 1);
+    QCOMPARE(files.at(8).filePath, QString("dir"));
+    for (int i = 0; i < contents.size(); ++i) {
+        QCOMPARE(files.at(i < 8 ? i : i + 1).filePath, QString::number(i));
+        QCOMPARE(zip2.fileData(QString::number(i)), contents.at(i));
+    }
+}
+
+void tst_QZip::zip64ManyEntries()
+{
+    // more than 65535 entries need the zip64 end of central directory
+    constexpr int Count = 70000;
+    QBuffer buffer;
+    {
+        QZipWriter zip(&buffer);
+        zip.setCompressionPolicy(QZipWriter::NeverCompress);
+        for (int i = 0; i < Count; ++i)
+            zip.addFile(QString::number(i), QByteArray::number(i));
+    }
+    QByteArray zipFile = buffer.buffer();
+
+    QBuffer buffer2(&zipFile);
+    QZipReader zip2(&buffer2);
+    QCOMPARE(zip2.count(), Count);
+    QCOMPARE(zip2.entryInfoAt(Count - 1).filePath, QString::number(Count - 1));
+    QCOMPARE(zip2.fileData(QString::number(Count - 1)), QByteArray::number(Count - 1));
+}
+
 QTEST_MAIN(tst_QZip)
 #include "tst_qzip.moc"
@@ -0,0 +1,257 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QSignalSpy>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QSharedMemory>
+#include <QtCore/private/qsharedringbuffer_p.h>
+
+#include <memory>
+#include <vector>
+
+using namespace Qt::StringLiterals;
+
+class tst_QSharedRingBuffer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void createAndAttach();
+    void attachToForeignSegment();
+    void roundTrip();
+    void fullBuffer();
+    void oversizedMessage();
+    void waitForReadyReadTimeout();
+    void singleProducerThreads();
+    void multiProducerThreads();
+    void notifications();
+
+private:
+    QNativeIpcKey uniqueKey()
+    {
+        const QString name = u"tst_qsharedringbuffer_%1_%2"_s
+                .arg(QCoreApplication::applicationPid()).arg(++keyCounter);
+        return QSharedMemory::platformSafeKey(name);
+    }
+
+    int keyCounter = 0;
+};
+
+static QByteArray payload(int i)
+{
+    // varying sizes so records straddle the end of the ring
+    return QByteArray::number(i).repeated(1 + i % 37);
+}
+
+void tst_QSharedRingBuffer::createAndAttach()
+{
+    const QNativeIpcKey key = uniqueKey();
+    QSharedRingBuffer producer(key);
+    QVERIFY2(producer.create(10000, QSharedRingBuffer::MultiProducer),
+             qPrintable(producer.errorString()));
+    QVERIFY(producer.isAttached());
+    QCOMPARE(producer.capacity(), 16384);
+    QCOMPARE(producer.maxMessageSize(), 8192 - 8);
+    QVERIFY(!producer.create(4096));
+
+    QSharedRingBuffer consumer(key);
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+    QCOMPARE(consumer.capacity(), producer.capacity());
+    QCOMPARE(consumer.producerMode(), QSharedRingBuffer::MultiProducer);
+
+    QVERIFY(consumer.detach());
+    QVERIFY(!consumer.isAttached());
+    QVERIFY(!consumer.hasMessage());
+    QVERIFY(!consumer.tryRead(nullptr));
+}
+
+void tst_QSharedRingBuffer::attachToForeignSegment()
+{
+    const QNativeIpcKey key = uniqueKey();
+    QSharedMemory memory(key);
+    QVERIFY(memory.create(8192));
+    memset(memory.data(), 0, memory.size());
+
+    QSharedRingBuffer buffer(key);
+    QVERIFY(!buffer.attach());
+    QVERIFY(!buffer.isAttached());
+    QVERIFY(!buffer.errorString().isEmpty());
+}
+
+void tst_QSharedRingBuffer::roundTrip()
+{
+    const QNativeIpcKey key = uniqueKey();
+    QSharedRingBuffer producer(key);
+    QVERIFY(producer.create(4096));
+    QSharedRingBuffer consumer(key);
+    QVERIFY(consumer.attach());
+
+    QByteArray message;
+    QVERIFY(!consumer.tryRead(&message));
+
+    // several laps around the ring, keeping a few messages in flight
+    int read = 0;
+    for (int written = 0; written < 2000; ++written) {
+        QVERIFY(producer.tryWrite(payload(written)));
+        if (written % 3 == 2) {
+            while (consumer.tryRead(&message))
+                QCOMPARE(message, payload(read++));
+        }
+    }
+    while (consumer.tryRead(&message))
+        QCOMPARE(message, payload(read++));
+    QCOMPARE(read, 2000);
+
+    QVERIFY(producer.tryWrite({}));
+    QVERIFY(consumer.hasMessage());
+    QVERIFY(consumer.tryRead(&message));
+    QVERIFY(message.isEmpty());
+    QVERIFY(!consumer.hasMessage());
+}
+
+void tst_QSharedRingBuffer::fullBuffer()
+{
+    const QNativeIpcKey key = uniqueKey();
+    QSharedRingBuffer producer(key);
+    QVERIFY(producer.create(4096));
+    QSharedRingBuffer consumer(key);
+    QVERIFY(consumer.attach());
+
+    const QByteArray chunk(100, 'x');
+    int count = 0;
+    while (producer.tryWrite(chunk))
+        ++count;
+    QCOMPARE(count, 4096 / 112);
+    QVERIFY(!producer.write(chunk, QDeadlineTimer(10)));
+
+    QByteArray message;
+    QVERIFY(consumer.tryRead(&message));
+    QCOMPARE(message, chunk);
+    QVERIFY(producer.tryWrite(chunk));
+}
+
+void tst_QSharedRingBuffer::oversizedMessage()
+{
+    QSharedRingBuffer producer(uniqueKey());
+    QVERIFY(producer.create(4096));
+    QVERIFY(producer.tryWrite(QByteArray(producer.maxMessageSize(), 'a')));
+    QVERIFY(!producer.tryWrite(QByteArray(producer.maxMessageSize() + 1, 'a')));
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("exceeds the maximum"));
+    QVERIFY(!producer.write(QByteArray(producer.maxMessageSize() + 1, 'a')));
+}
+
+void tst_QSharedRingBuffer::waitForReadyReadTimeout()
+{
+    QSharedRingBuffer consumer(uniqueKey());
+    QVERIFY(consumer.create(4096));
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(!consumer.waitForReadyRead(QDeadlineTimer(50)));
+    QVERIFY(timer.elapsed() >= 40);
+
+    QVERIFY(consumer.tryWrite("x"));
+    QVERIFY(consumer.waitForReadyRead(QDeadlineTimer(0)));
+}
+
+void tst_QSharedRingBuffer::singleProducerThreads()
+{
+    constexpr int MessageCount = 100000;
+    const QNativeIpcKey key = uniqueKey();
+    QSharedRingBuffer consumer(key);
+    QVERIFY(consumer.create(8192));
+
+    std::unique_ptr<QThread> thread(QThread::create([&key] {
+        QSharedRingBuffer producer(key);
+        if (!producer.attach())
+            return;
+        for (int i = 0; i < MessageCount; ++i)
+            producer.write(payload(i));
+    }));
+    thread->start();
+
+    QByteArray message;
+    int i = 0;
+    for (; i < MessageCount; ++i) {
+        if (!consumer.waitForReadyRead(QDeadlineTimer(10000)))
+            break;
+        QVERIFY(consumer.tryRead(&message));
+        QCOMPARE(message, payload(i));
+    }
+    QVERIFY(thread->wait(10000));
+    QCOMPARE(i, MessageCount);
+}
+
+void tst_QSharedRingBuffer::multiProducerThreads()
+{
+    constexpr int ProducerCount = 4;
+    constexpr int MessageCount = 20000;
+    const QNativeIpcKey key = uniqueKey();
+    QSharedRingBuffer consumer(key);
+    QVERIFY(consumer.create(4096, QSharedRingBuffer::MultiProducer));
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int p = 0; p < ProducerCount; ++p) {
+        threads.emplace_back(QThread::create([&key, p] {
+            QSharedRingBuffer producer(key);
+            if (!producer.attach())
+                return;
+            for (int i = 0; i < MessageCount; ++i)
+                producer.write(QByteArray::number(p) + ':' + QByteArray::number(i));
+        }));
+        threads.back()->start();
+    }
+
+    int next[ProducerCount] = {};
+    QByteArray message;
+    for (int n = 0; n < ProducerCount * MessageCount; ++n) {
+        QVERIFY(consumer.waitForReadyRead(QDeadlineTimer(10000)));
+        QVERIFY(consumer.tryRead(&message));
+        const qsizetype colon = message.indexOf(':');
+        QVERIFY(colon > 0);
+        const int p = message.left(colon).toInt();
+        QVERIFY(p >= 0 && p < ProducerCount);
+        QCOMPARE(message.mid(colon + 1).toInt(), next[p]++);
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait(10000));
+    QVERIFY(!consumer.hasMessage());
+}
+
+void tst_QSharedRingBuffer::notifications()
+{
+    const QNativeIpcKey key = uniqueKey();
+    QSharedRingBuffer consumer(key);
+    QSignalSpy spy(&consumer, &QSharedRingBuffer::readyRead);
+    consumer.setNotificationsEnabled(true);
+    QVERIFY(consumer.notificationsEnabled());
+    QVERIFY(consumer.create(4096));
+
+    QSharedRingBuffer producer(key);
+    QVERIFY(producer.attach());
+    QVERIFY(producer.tryWrite("hello"));
+    QTRY_VERIFY(spy.size() >= 1);
+
+    QByteArray message;
+    QVERIFY(consumer.tryRead(&message));
+    QCOMPARE(message, "hello");
+
+    spy.clear();
+    QVERIFY(producer.tryWrite("again"));
+    QTRY_VERIFY(spy.size() >= 1);
+    QVERIFY(consumer.tryRead(&message));
+    QCOMPARE(message, "again");
+
+    consumer.setNotificationsEnabled(false);
+    spy.clear();
+    QVERIFY(producer.tryWrite("quiet"));
+    QTest::qWait(50);
+    QCOMPARE(spy.size(), 0);
+}
+
+QTEST_MAIN(tst_QSharedRingBuffer)
+#include "tst_qsharedringbuffer.moc"
@@ -983,6 +983,48 @@ void tst_QMimeDatabase::fromThreads()
     QVERIFY(tp.waitForDone(60000));
 }
 
+void tst_QMimeDatabase::mimeTypesForFiles_data()
+{
+    QTest::addColumn<QMimeDatabase::MatchMode>("mode");
+
+    QTest::newRow("default") << QMimeDatabase::MatchDefault;
+    QTest::newRow("extension") << QMimeDatabase::MatchExtension;
+    QTest::newRow("content") << QMimeDatabase::MatchContent;
+}
+
+void tst_QMimeDatabase::mimeTypesForFiles()
+{
+    QFETCH(QMimeDatabase::MatchMode, mode);
+
+    QTemporaryFile pdfFile;
+    QVERIFY(pdfFile.open());
+    pdfFile.write("%PDF-");
+    pdfFile.close();
+    QTemporaryFile txtFile(QDir::tempPath() + "/tst_QMimeDatabase_XXXXXX.txt"_L1);
+    QVERIFY(txtFile.open());
+    txtFile.write("<smil");
+    txtFile.close();
+    QTemporaryFile emptyFile;
+    QVERIFY(emptyFile.open());
+    emptyFile.close();
+
+    QStringList fileNames = {
+        pdfFile.fileName(), txtFile.fileName(), emptyFile.fileName(),
+        u"/"_s, u":/files/test.txt"_s, u"doesnotexist.odt"_s,
+    };
+    // enough files for the work to be spread over several threads
+    for (int i = 0; i < 5; ++i)
+        fileNames += fileNames;
+
+    QMimeDatabase db;
+    const QList<QMimeType> mimeTypes = db.mimeTypesForFiles(fileNames, mode);
+    QCOMPARE(mimeTypes.size(), fileNames.size());
+    for (qsizetype i = 0; i < fileNames.size(); ++i)
+        QCOMPARE(mimeTypes.at(i), db.mimeTypeForFile(fileNames.at(i), mode));
+
+    QVERIFY(db.mimeTypesForFiles({}, mode).isEmpty());
+}
+
 #if QT_CONFIG(process)
 
 enum {
@@ -47,6 +47,8 @@ private slots:
     void knownSuffix();
     void symlinkToFifo();
     void fromThreads();
+    void mimeTypesForFiles_data();
+    void mimeTypesForFiles();
 
     // shared-mime-info test suite
 
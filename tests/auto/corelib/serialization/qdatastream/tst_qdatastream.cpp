@@ -179,6 +179,9 @@ private slots:
 
     void status_QList_QVector();
 
+    void bulkNumericLists_data();
+    void bulkNumericLists();
+
     void streamToAndFromQByteArray();
 
     void streamRealDataTypes();
@@ -3189,6 +3192,106 @@ void tst_QDataStream::status_QList_QVector()
     }
 }
 
+void tst_QDataStream::bulkNumericLists_data()
+{
+    QTest::addColumn<QDataStream::ByteOrder>("byteOrder");
+    QTest::addColumn<QDataStream::FloatingPointPrecision>("precision");
+    QTest::addColumn<int>("version");
+
+    QTest::newRow("BE/double/current") << QDataStream::BigEndian
+                                        << QDataStream::DoublePrecision
+                                        << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("LE/double/current") << QDataStream::LittleEndian
+                                        << QDataStream::DoublePrecision
+                                        << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("BE/single/current") << QDataStream::BigEndian
+                                        << QDataStream::SinglePrecision
+                                        << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("LE/single/current") << QDataStream::LittleEndian
+                                        << QDataStream::SinglePrecision
+                                        << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("BE/Qt_3_1") << QDataStream::BigEndian << QDataStream::DoublePrecision
+                               << int(QDataStream::Qt_3_1);
+    QTest::newRow("LE/Qt_3_1") << QDataStream::LittleEndian << QDataStream::DoublePrecision
+                               << int(QDataStream::Qt_3_1);
+}
+
+template <typename T>
+static void checkBulkNumericList(QDataStream::ByteOrder byteOrder,
+                                 QDataStream::FloatingPointPrecision precision, int version)
+{
+    QList<T> list;
+    for (int i = 0; i < 10000; ++i)
+        list.append(T(i * 7919 - 5000) / T(3));
+
+    auto setUp = [&](QDataStream &s) {
+        s.setByteOrder(byteOrder);
+        s.setFloatingPointPrecision(precision);
+        s.setVersion(version);
+    };
+
+    QByteArray expected;
+    {
+        QDataStream out(&expected, QIODevice::WriteOnly);
+        setUp(out);
+        out << quint32(list.size());
+        for (T t : std::as_const(list))
+            out << t;
+    }
+
+    QByteArray data;
+    {
+        QDataStream out(&data, QIODevice::WriteOnly);
+        setUp(out);
+        out << list;
+        QCOMPARE(out.status(), QDataStream::Ok);
+    }
+    QCOMPARE(data, expected);
+
+    {
+        QDataStream in(data);
+        setUp(in);
+        QList<T> result;
+        in >> result;
+        QCOMPARE(in.status(), QDataStream::Ok);
+        QVERIFY(in.atEnd());
+        if constexpr (std::is_floating_point_v<T>) {
+            if (precision == QDataStream::SinglePrecision && version >= QDataStream::Qt_4_6) {
+                for (T &t : list)
+                    t = T(float(t));
+            }
+        }
+        QCOMPARE(result, list);
+    }
+
+    // truncated data must not produce a partially filled list
+    {
+        QDataStream in(data.left(data.size() - 1));
+        setUp(in);
+        QList<T> result{T(1)};
+        in >> result;
+        QCOMPARE(in.status(), QDataStream::ReadPastEnd);
+        QVERIFY(result.isEmpty());
+    }
+}
+
+void tst_QDataStream::bulkNumericLists()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    QFETCH(QDataStream::FloatingPointPrecision, precision);
+    QFETCH(int, version);
+
+    checkBulkNumericList<qint8>(byteOrder, precision, version);
+    checkBulkNumericList<quint16>(byteOrder, precision, version);
+    checkBulkNumericList<qint32>(byteOrder, precision, version);
+    checkBulkNumericList<quint32>(byteOrder, precision, version);
+    // 64-bit integers have a different layout before Qt 3.3
+    if (version >= QDataStream::Qt_3_3)
+        checkBulkNumericList<qint64>(byteOrder, precision, version);
+    checkBulkNumericList<float>(byteOrder, precision, version);
+    checkBulkNumericList<double>(byteOrder, precision, version);
+}
+
 void tst_QDataStream::streamToAndFromQByteArray()
 {
     QByteArray data;
@@ -19,6 +19,7 @@ private slots:
     void readPointerAtPositionEmptyRead();
     void readPointerAtPositionWithHead();
     void readPointerAtPositionReadTooMuch();
+    void readPointers();
     void sizeWhenReservedAndChopped();
     void sizeWhenReserved();
     void free();
@@ -104,6 +105,26 @@ void tst_QRingBuffer::readPointerAtPositionReadTooMuch()
     QCOMPARE(length, Q_INT64_C(0));
 }
 
+void tst_QRingBuffer::readPointers()
+{
+    QRingBuffer ringBuffer;
+    QByteArrayView blocks[4];
+    QCOMPARE(ringBuffer.readPointers(blocks, 4), 0);
+
+    ringBuffer.append(QByteArray("0123"));
+    ringBuffer.append(QByteArray("456"));
+    ringBuffer.append(QByteArray("78"));
+    ringBuffer.free(1);
+
+    QCOMPARE(ringBuffer.readPointers(blocks, 4), 3);
+    QCOMPARE(blocks[0], "123");
+    QCOMPARE(blocks[1], "456");
+    QCOMPARE(blocks[2], "78");
+
+    QCOMPARE(ringBuffer.readPointers(blocks, 2), 2);
+    QCOMPARE(blocks[1], "456");
+}
+
 void tst_QRingBuffer::readPointerAtPositionWithHead()
 {
     QRingBuffer ringBuffer;
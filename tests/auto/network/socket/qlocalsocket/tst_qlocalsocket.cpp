@@ -107,6 +107,7 @@ private slots:
 
     void multiConnect();
     void writeOnlySocket();
+    void corkedWrites();
 
     void writeToClientAndDisconnect_data();
     void writeToClientAndDisconnect();
@@ -1493,6 +1494,54 @@ void tst_QLocalSocket::writeOnlySocket()
     QCOMPARE(client.state(), QLocalSocket::UnconnectedState);
 }
 
+void tst_QLocalSocket::corkedWrites()
+{
+    CrashSafeLocalServer server;
+    QVERIFY2(server.listen("corkedWrites"), qUtf8Printable(server.errorString()));
+
+    QLocalSocket client;
+    client.connectToServer("corkedWrites");
+    QVERIFY(client.waitForConnected());
+    QVERIFY(server.waitForNewConnection(200));
+    QLocalSocket *serverSocket = server.nextPendingConnection();
+    QVERIFY(serverSocket);
+
+    client.cork();
+    client.cork();
+    QVERIFY(client.isCorked());
+
+    // mix small and large messages, so the write buffer holds many blocks
+    QByteArray expected;
+    for (int i = 0; i < 50; ++i) {
+        const QByteArray message = QByteArray::number(i) + ':'
+                + QByteArray(i * 1000, char('a' + i % 26)) + '\n';
+        QCOMPARE(client.write(message), message.size());
+        expected += message;
+    }
+    QTest::qWait(50);
+    QCOMPARE(serverSocket->bytesAvailable(), 0);
+
+    client.uncork();
+    QVERIFY(client.isCorked());
+    QTest::qWait(20);
+    QCOMPARE(serverSocket->bytesAvailable(), 0);
+
+    client.uncork();
+    QVERIFY(!client.isCorked());
+
+    QByteArray received;
+    connect(serverSocket, &QLocalSocket::readyRead, this, [&] {
+        received += serverSocket->readAll();
+    });
+    received += serverSocket->readAll();
+    QTRY_COMPARE(received.size(), expected.size());
+    QCOMPARE(received, expected);
+
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QIODevice::uncork (QLocalSocket): Called without a matching cork()");
+    client.uncork();
+}
+
 void tst_QLocalSocket::writeToClientAndDisconnect_data()
 {
     QTest::addColumn<int>("chunks");
@@ -47,6 +47,8 @@ private slots:
     void benchMimeTypeForName();
     void benchMimeTypeForFile_data();
     void benchMimeTypeForFile();
+    void benchMimeTypesForFiles_data();
+    void benchMimeTypesForFiles();
 };
 
 void tst_QMimeDatabase::inheritsPerformance()
@@ -141,6 +143,49 @@ void tst_QMimeDatabase::benchMimeTypeForFile()
     }
 }
 
+void tst_QMimeDatabase::benchMimeTypesForFiles_data()
+{
+    QTest::addColumn<QMimeDatabase::MatchMode>("mode");
+    QTest::addColumn<bool>("batch");
+
+    for (const MatchModeInfo &info : matchModes) {
+        QTest::addRow("%s - one by one", info.name) << info.mode << false;
+        QTest::addRow("%s - batch", info.name) << info.mode << true;
+    }
+}
+
+void tst_QMimeDatabase::benchMimeTypesForFiles()
+{
+    QFETCH(const QMimeDatabase::MatchMode, mode);
+    QFETCH(const bool, batch);
+
+    QStringList fileNames;
+    for (const char *name : { "N.tar.gz", "t.c", "u.txt", "X", "y", "z" }) {
+        const QString filePath = QFINDTESTDATA(u"files/"_s + QLatin1StringView(name));
+        QVERIFY(!filePath.isEmpty());
+        fileNames.append(filePath);
+    }
+    // an ingest-like workload: many files, most of which need their contents read
+    constexpr int Repetitions = 200;
+    QStringList allFileNames;
+    allFileNames.reserve(fileNames.size() * Repetitions);
+    for (int i = 0; i < Repetitions; ++i)
+        allFileNames += fileNames;
+
+    QMimeDatabase db;
+    QList<QMimeType> mimeTypes;
+    QBENCHMARK {
+        if (batch) {
+            mimeTypes = db.mimeTypesForFiles(allFileNames, mode);
+        } else {
+            mimeTypes.clear();
+            for (const QString &fileName : std::as_const(allFileNames))
+                mimeTypes.append(db.mimeTypeForFile(fileName, mode));
+        }
+    }
+    QCOMPARE(mimeTypes.size(), allFileNames.size());
+}
+
 QTEST_MAIN(tst_QMimeDatabase)
 
 #include "tst_bench_qmimedatabase.moc"